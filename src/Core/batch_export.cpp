@@ -0,0 +1,275 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// Prototyper include.
+#include "batch_export.hpp"
+#include "exporter/html_exporter.hpp"
+#include "exporter/pdf_exporter.hpp"
+#include "exporter/svg_exporter.hpp"
+#include "project_bundle.hpp"
+#include "project_cfg.hpp"
+#include "project_file.hpp"
+#include "project_index.hpp"
+
+// Qt include.
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QTextStream>
+
+// C++ include.
+#include <memory>
+
+namespace Prototyper
+{
+
+namespace Core
+{
+
+static const QString c_pdfFormat = QStringLiteral("pdf");
+static const QString c_svgFormat = QStringLiteral("svg");
+static const QString c_htmlFormat = QStringLiteral("html");
+
+//! Print result of the batch export.
+static inline int printResult(QJsonObject &res,
+                              int code,
+                              const QString &error = QString())
+{
+    res.insert(QStringLiteral("status"), (code == BatchExportOk ? QStringLiteral("ok") : QStringLiteral("error")));
+    res.insert(QStringLiteral("exitCode"), code);
+
+    if (!error.isEmpty()) {
+        res.insert(QStringLiteral("error"), error);
+    }
+
+    QTextStream stream(code == BatchExportOk ? stdout : stderr);
+    stream << QJsonDocument(res).toJson(QJsonDocument::Compact) << Qt::endl;
+
+    return code;
+}
+
+//! \return Is file writable? Present file is left as is.
+static inline bool isWritable(const QString &fileName)
+{
+    const QFileInfo info(fileName);
+
+    if (info.exists()) {
+        return (info.isFile() && info.isWritable());
+    }
+
+    const QFileInfo dir(info.absolutePath());
+
+    return (dir.isDir() && dir.isWritable());
+}
+
+int batchUsage(const QString &usage,
+               const QString &error)
+{
+    QJsonObject res;
+    res.insert(QStringLiteral("usage"), usage);
+
+    return printResult(res, (error.isEmpty() ? BatchExportOk : BatchExportWrongArguments), error);
+}
+
+int batchExport(const QString &format,
+                const QString &input,
+                const QString &output)
+{
+    QJsonObject res;
+    res.insert(QStringLiteral("format"), format);
+    res.insert(QStringLiteral("input"), input);
+    res.insert(QStringLiteral("output"), output);
+
+    if (format != c_pdfFormat && format != c_svgFormat && format != c_htmlFormat) {
+        return printResult(res,
+                           BatchExportWrongArguments,
+                           QStringLiteral("Unknown export format \"%1\". Use pdf, svg or html.").arg(format));
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    Cfg::Project cfg;
+
+    try {
+        cfg = readProjectFile(input);
+    } catch (const ProjectFileException &x) {
+        return printResult(res, BatchExportUnableToReadProject, x.what());
+    }
+
+    res.insert(QStringLiteral("readMs"), timer.restart());
+    res.insert(QStringLiteral("pages"), static_cast<int>(cfg.page().size()));
+
+    std::unique_ptr<Exporter> exporter;
+
+    if (format == c_svgFormat) {
+        if (!QDir().mkpath(output)) {
+            return printResult(res, BatchExportUnableToExport, QStringLiteral("Unable to create directory."));
+        }
+
+        exporter.reset(new SvgExporter(cfg));
+    } else {
+        if (!isWritable(output)) {
+            return printResult(res, BatchExportUnableToExport, QStringLiteral("File is not writable."));
+        }
+
+        if (format == c_pdfFormat) {
+            exporter.reset(new PdfExporter(cfg));
+        } else {
+            exporter.reset(new HtmlExporter(cfg));
+        }
+    }
+
+    try {
+        exporter->exportToDoc(output);
+    } catch (const SvgExporterException &x) {
+        return printResult(res, BatchExportUnableToExport, x.what());
+    }
+
+    res.insert(QStringLiteral("exportMs"), timer.elapsed());
+    res.insert(QStringLiteral("imageCacheHits"), exporter->imageCacheHits());
+    res.insert(QStringLiteral("imageCacheMisses"), exporter->imageCacheMisses());
+
+    return printResult(res, BatchExportOk);
+}
+
+int convertProject(const QString &input,
+                   const QString &output)
+{
+    QJsonObject res;
+    res.insert(QStringLiteral("input"), input);
+    res.insert(QStringLiteral("output"), output);
+
+    const ProjectFormat format = projectFormatForFileName(output);
+
+    switch (format) {
+    case BinaryProjectFormat:
+        res.insert(QStringLiteral("format"), QStringLiteral("binary"));
+        break;
+
+    case CompressedProjectFormat:
+        res.insert(QStringLiteral("format"), QStringLiteral("compressed"));
+        break;
+
+    case BundleProjectFormat:
+        res.insert(QStringLiteral("format"), QStringLiteral("bundle"));
+        break;
+
+    default:
+        res.insert(QStringLiteral("format"), QStringLiteral("text"));
+        break;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    Cfg::Project cfg;
+
+    try {
+        cfg = readProjectFile(input);
+    } catch (const ProjectFileException &x) {
+        return printResult(res, BatchExportUnableToReadProject, x.what());
+    }
+
+    res.insert(QStringLiteral("readMs"), timer.restart());
+
+    if (format == BundleProjectFormat) {
+        try {
+            writeBundle(output, cfg);
+        } catch (const ProjectFileException &x) {
+            return printResult(res, BatchExportUnableToExport, x.what());
+        }
+
+        res.insert(QStringLiteral("writeMs"), timer.elapsed());
+
+        return printResult(res, BatchExportOk);
+    }
+
+    QSaveFile file(output);
+
+    if (!file.open(QIODevice::WriteOnly)) {
+        return printResult(res, BatchExportUnableToExport, QStringLiteral("File is not writable."));
+    }
+
+    try {
+        writeProjectFile(cfg, file, format);
+    } catch (const ProjectFileException &x) {
+        file.cancelWriting();
+
+        return printResult(res, BatchExportUnableToExport, x.what());
+    }
+
+    if (!file.commit()) {
+        return printResult(res, BatchExportUnableToExport, file.errorString());
+    }
+
+    res.insert(QStringLiteral("writeMs"), timer.elapsed());
+    res.insert(QStringLiteral("bytes"), QFileInfo(output).size());
+
+    return printResult(res, BatchExportOk);
+}
+
+int listProject(const QString &input)
+{
+    QJsonObject res;
+    res.insert(QStringLiteral("input"), input);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    ProjectIndex index;
+    bool indexed = false;
+
+    try {
+        // Manifest of the bundle has no counts of elements.
+        if (!isProjectBundle(input)) {
+            indexed = readProjectIndex(input, index);
+        }
+
+        if (!indexed) {
+            const Cfg::Project cfg = readProjectFile(input);
+
+            for (const auto &page : cfg.page()) {
+                ProjectIndexPage p;
+                p.m_tabName = page.tabName();
+                p.m_elements = pageElementsCount(page);
+
+                index.m_pages.push_back(p);
+            }
+        }
+    } catch (const ProjectFileException &x) {
+        return printResult(res, BatchExportUnableToReadProject, x.what());
+    }
+
+    QJsonArray pages;
+
+    for (const auto &page : index.m_pages) {
+        QJsonObject p;
+        p.insert(QStringLiteral("name"), page.m_tabName);
+        p.insert(QStringLiteral("elements"), page.m_elements);
+
+        if (indexed) {
+            p.insert(QStringLiteral("offset"), page.m_offset);
+            p.insert(QStringLiteral("size"), page.m_size);
+            p.insert(QStringLiteral("thumbnailBytes"), page.m_thumbnail.size());
+        }
+
+        pages.append(p);
+    }
+
+    res.insert(QStringLiteral("indexed"), indexed);
+    res.insert(QStringLiteral("pages"), pages);
+    res.insert(QStringLiteral("readMs"), timer.elapsed());
+
+    return printResult(res, BatchExportOk);
+}
+
+} /* namespace Core */
+
+} /* namespace Prototyper */
@@ -0,0 +1,84 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#ifndef PROTOTYPER__CORE__BATCH_EXPORT_HPP__INCLUDED
+#define PROTOTYPER__CORE__BATCH_EXPORT_HPP__INCLUDED
+
+// Qt include.
+#include <QString>
+
+// Prototyper include.
+#include "export.hpp"
+
+namespace Prototyper
+{
+
+namespace Core
+{
+
+//
+// BatchExportResult
+//
+
+//! Exit code of the batch export.
+enum BatchExportResult {
+    //! Project exported.
+    BatchExportOk = 0,
+    //! Wrong command line arguments.
+    BatchExportWrongArguments = 1,
+    //! Unable to read project.
+    BatchExportUnableToReadProject = 2,
+    //! Unable to export project.
+    BatchExportUnableToExport = 3
+}; // enum BatchExportResult
+
+//
+// batchUsage
+//
+
+//! Print \a usage of the batch mode, with \a error in the command line if any.
+//! Writes one line of JSON to the standard output, or to the standard error on error.
+//! \return Exit code, see BatchExportResult.
+PROTOTYPER_CORE_EXPORT int batchUsage(const QString &usage,
+                                      const QString &error = QString());
+
+//
+// batchExport
+//
+
+//! Export project without GUI.
+//! \a format is one of "pdf", "svg" or "html". For SVG \a output is a directory.
+//! Writes one line of JSON with the result and timings to the standard output.
+//! \return Exit code, see BatchExportResult.
+PROTOTYPER_CORE_EXPORT int batchExport(const QString &format,
+                                       const QString &input,
+                                       const QString &output);
+
+//
+// convertProject
+//
+
+//! Convert project between the text and the binary formats without GUI.
+//! Format of \a output is chosen by its extension: ".prototyperb" is binary,
+//! anything else is text. Writes one line of JSON with the result to the standard output.
+//! \return Exit code, see BatchExportResult.
+PROTOTYPER_CORE_EXPORT int convertProject(const QString &input,
+                                          const QString &output);
+
+//
+// listProject
+//
+
+//! List pages of the project without GUI. Pages are taken from the index
+//! at the head of the file, the project is read as a whole only if there
+//! is no index. Writes one line of JSON with the pages to the standard output.
+//! \return Exit code, see BatchExportResult.
+PROTOTYPER_CORE_EXPORT int listProject(const QString &input);
+
+} /* namespace Core */
+
+} /* namespace Prototyper */
+
+#endif // PROTOTYPER__CORE__BATCH_EXPORT_HPP__INCLUDED
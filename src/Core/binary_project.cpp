@@ -0,0 +1,1179 @@
+
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// Prototyper include.
+#include "binary_project.hpp"
+#include "project_cfg.hpp"
+#include "project_file.hpp"
+#include "project_index.hpp"
+
+// Qt include.
+#include <QDataStream>
+#include <QHash>
+#include <QIODevice>
+#include <QObject>
+#include <QVector>
+
+// C++ include.
+#include <vector>
+
+namespace Prototyper
+{
+
+namespace Core
+{
+
+//! \return Id of the chunk.
+static constexpr quint32 chunkId(char a,
+                                 char b,
+                                 char c,
+                                 char d)
+{
+    return (quint32(quint8(a)) | (quint32(quint8(b)) << 8) | (quint32(quint8(c)) << 16) | (quint32(quint8(d)) << 24));
+}
+
+static const QByteArray c_binaryMagic = QByteArrayLiteral("PRTB");
+static const quint16 c_binaryVersion = 1;
+
+static constexpr quint32 c_indexChunk = chunkId('T', 'O', 'C', ' ');
+static constexpr quint32 c_stringsChunk = chunkId('S', 'T', 'R', 'S');
+static constexpr quint32 c_projectChunk = chunkId('P', 'R', 'O', 'J');
+static constexpr quint32 c_pageChunk = chunkId('P', 'A', 'G', 'E');
+static constexpr quint32 c_imageChunk = chunkId('I', 'M', 'A', 'G');
+static constexpr quint32 c_endChunk = chunkId('E', 'N', 'D', ' ');
+
+//! Setup stream for the binary project.
+static inline void setupStream(QDataStream &s)
+{
+    s.setVersion(QDataStream::Qt_6_0);
+    s.setByteOrder(QDataStream::LittleEndian);
+    s.setFloatingPointPrecision(QDataStream::DoublePrecision);
+}
+
+//! Size of the header of the binary project.
+static const qint64 c_headerSize = 4 + 2 + 2;
+//! Size of the header of the chunk.
+static const qint64 c_chunkHeaderSize = 4 + 8;
+
+//! Read and check header of the binary project.
+//! \throw ProjectFileException on error.
+static void readHeader(QDataStream &in)
+{
+    QByteArray magic(c_binaryMagic.size(), 0);
+    in.readRawData(magic.data(), magic.size());
+
+    quint16 version = 0;
+    quint16 flags = 0;
+    in >> version >> flags;
+
+    if (in.status() != QDataStream::Ok || magic != c_binaryMagic) {
+        throw ProjectFileException(QObject::tr("Not a binary project."));
+    }
+
+    if (version > c_binaryVersion) {
+        throw ProjectFileException(QObject::tr("Unsupported version %1 of the binary project.").arg(version));
+    }
+}
+
+//! \return Payload of the next chunk.
+//! \throw ProjectFileException on error.
+static QByteArray readChunk(QDataStream &in,
+                            quint32 &id)
+{
+    QIODevice &device = *in.device();
+
+    quint64 size = 0;
+    in >> id >> size;
+
+    if (in.status() != QDataStream::Ok) {
+        throw ProjectFileException(QObject::tr("Binary project is corrupted."));
+    }
+
+    if (!device.isSequential() && size > quint64(device.size() - device.pos())) {
+        throw ProjectFileException(QObject::tr("Binary project is truncated."));
+    }
+
+    QByteArray payload(qsizetype(size), Qt::Uninitialized);
+
+    if (in.readRawData(payload.data(), payload.size()) != payload.size()) {
+        throw ProjectFileException(QObject::tr("Binary project is truncated."));
+    }
+
+    return payload;
+}
+
+//! \return Payload of the index chunk.
+static QByteArray printIndex(const ProjectIndex &index)
+{
+    QByteArray payload;
+    QDataStream s(&payload, QIODevice::WriteOnly);
+    setupStream(s);
+
+    // Strings are written in place, the index is read without the table.
+    s << quint32(index.m_pages.size());
+
+    for (const auto &page : index.m_pages) {
+        s << page.m_tabName << quint64(page.m_offset) << quint64(page.m_size) << quint32(page.m_elements)
+          << page.m_thumbnail;
+    }
+
+    return payload;
+}
+
+//
+// BinaryProjectWriter
+//
+
+//! Writer of the binary project.
+class BinaryProjectWriter final
+{
+public:
+    BinaryProjectWriter() = default;
+
+    //! Write project.
+    void write(const Cfg::Project &cfg,
+               QIODevice &device,
+               const ProjectIndex *index);
+
+private:
+    //! \return Index of the string in the table.
+    quint32 string(const QString &s);
+    //! Write chunk.
+    static void writeChunk(QDataStream &out,
+                           quint32 id,
+                           const QByteArray &payload);
+
+    void put(QDataStream &s,
+             const QString &v);
+    void put(QDataStream &s,
+             double v);
+    void put(QDataStream &s,
+             bool v);
+    void put(QDataStream &s,
+             int v);
+    void put(QDataStream &s,
+             const Cfg::Point &c);
+    void put(QDataStream &s,
+             const Cfg::Size &c);
+    void put(QDataStream &s,
+             const Cfg::Pen &c);
+    void put(QDataStream &s,
+             const Cfg::Brush &c);
+    void put(QDataStream &s,
+             const Cfg::TextStyle &c);
+    void put(QDataStream &s,
+             const Cfg::Comment &c);
+    void put(QDataStream &s,
+             const Cfg::Comments &c);
+    void put(QDataStream &s,
+             const Cfg::Line &c);
+    void put(QDataStream &s,
+             const Cfg::Polyline &c);
+    void put(QDataStream &s,
+             const Cfg::Text &c);
+    void put(QDataStream &s,
+             const Cfg::Image &c);
+    void put(QDataStream &s,
+             const Cfg::Rect &c);
+    void put(QDataStream &s,
+             const Cfg::Button &c);
+    void put(QDataStream &s,
+             const Cfg::CheckBox &c);
+    void put(QDataStream &s,
+             const Cfg::ComboBox &c);
+    void put(QDataStream &s,
+             const Cfg::SpinBox &c);
+    void put(QDataStream &s,
+             const Cfg::HSlider &c);
+    void put(QDataStream &s,
+             const Cfg::VSlider &c);
+    void put(QDataStream &s,
+             const Cfg::Group &c);
+    void put(QDataStream &s,
+             const Cfg::Page &c);
+    void put(QDataStream &s,
+             const Cfg::ProjectDesc &c);
+
+    //! Write vector.
+    template<typename T>
+    void put(QDataStream &s,
+             const std::vector<T> &v)
+    {
+        s << quint32(v.size());
+
+        for (const auto &e : v) {
+            put(s, e);
+        }
+    }
+
+    //! Write element with pos, size, pen and brush.
+    template<typename T>
+    void putPlain(QDataStream &s,
+                  const T &c)
+    {
+        put(s, c.pos());
+        put(s, c.size());
+        put(s, c.pen());
+        put(s, c.brush());
+        put(s, c.objectId());
+        put(s, double(c.z()));
+    }
+
+    //! Write element with text, pos, size, pen and brush.
+    template<typename T>
+    void putWithText(QDataStream &s,
+                     const T &c)
+    {
+        put(s, c.text());
+        putPlain(s, c);
+    }
+
+private:
+    //! Strings.
+    QVector<QString> m_strings;
+    //! Indexes of strings.
+    QHash<QString, quint32> m_index;
+}; // class BinaryProjectWriter
+
+void BinaryProjectWriter::write(const Cfg::Project &cfg,
+                                QIODevice &device,
+                                const ProjectIndex *index)
+{
+    QByteArray project;
+
+    {
+        QDataStream s(&project, QIODevice::WriteOnly);
+        setupStream(s);
+
+        put(s, cfg.description());
+        put(s, double(cfg.defaultGridStep()));
+        put(s, cfg.showGrid());
+        put(s, double(cfg.precision()));
+    }
+
+    std::vector<QByteArray> pages;
+    pages.reserve(cfg.page().size());
+
+    for (const auto &page : cfg.page()) {
+        QByteArray data;
+        QDataStream s(&data, QIODevice::WriteOnly);
+        setupStream(s);
+
+        if (cfg.precision() > 0.0) {
+            Cfg::Page quantized = page;
+            quantizeGeometry(quantized, cfg.precision());
+
+            put(s, quantized);
+        } else {
+            put(s, page);
+        }
+
+        pages.push_back(data);
+    }
+
+    std::vector<QByteArray> images;
+    images.reserve(cfg.images().size());
+
+    for (const auto &image : cfg.images()) {
+        QByteArray data;
+        QDataStream s(&data, QIODevice::WriteOnly);
+        setupStream(s);
+
+        put(s, image.sha256());
+        put(s, image.format());
+        s << QByteArray::fromBase64(image.data().toLatin1());
+
+        images.push_back(data);
+    }
+
+    QByteArray strings;
+
+    {
+        QDataStream s(&strings, QIODevice::WriteOnly);
+        setupStream(s);
+
+        s << quint32(m_strings.size());
+
+        for (const auto &str : std::as_const(m_strings)) {
+            s << str;
+        }
+    }
+
+    QByteArray toc;
+
+    if (index) {
+        ProjectIndex i = *index;
+        i.m_pages.resize(pages.size());
+
+        // Offsets don't change the size of the index.
+        qint64 offset = c_headerSize + c_chunkHeaderSize + printIndex(i).size() + c_chunkHeaderSize + strings.size()
+            + c_chunkHeaderSize + project.size();
+
+        for (std::size_t p = 0; p < pages.size(); ++p) {
+            i.m_pages[p].m_offset = offset;
+            i.m_pages[p].m_size = c_chunkHeaderSize + pages[p].size();
+
+            offset += i.m_pages[p].m_size;
+        }
+
+        toc = printIndex(i);
+    }
+
+    QDataStream out(&device);
+    setupStream(out);
+
+    out.writeRawData(c_binaryMagic.constData(), c_binaryMagic.size());
+    out << c_binaryVersion << quint16(0);
+
+    if (index) {
+        writeChunk(out, c_indexChunk, toc);
+    }
+
+    writeChunk(out, c_stringsChunk, strings);
+    writeChunk(out, c_projectChunk, project);
+
+    for (const auto &page : pages) {
+        writeChunk(out, c_pageChunk, page);
+    }
+
+    for (const auto &image : images) {
+        writeChunk(out, c_imageChunk, image);
+    }
+
+    writeChunk(out, c_endChunk, QByteArray());
+
+    if (out.status() != QDataStream::Ok) {
+        throw ProjectFileException(QObject::tr("Unable to write binary project."));
+    }
+}
+
+quint32 BinaryProjectWriter::string(const QString &s)
+{
+    const auto it = m_index.constFind(s);
+
+    if (it != m_index.cend()) {
+        return it.value();
+    }
+
+    const auto idx = quint32(m_strings.size());
+
+    m_strings.append(s);
+    m_index.insert(s, idx);
+
+    return idx;
+}
+
+void BinaryProjectWriter::writeChunk(QDataStream &out,
+                                     quint32 id,
+                                     const QByteArray &payload)
+{
+    out << id << quint64(payload.size());
+    out.writeRawData(payload.constData(), payload.size());
+}
+
+void BinaryProjectWriter::put(QDataStream &s,
+                              const QString &v)
+{
+    s << string(v);
+}
+
+void BinaryProjectWriter::put(QDataStream &s,
+                              double v)
+{
+    s << v;
+}
+
+void BinaryProjectWriter::put(QDataStream &s,
+                              bool v)
+{
+    s << v;
+}
+
+void BinaryProjectWriter::put(QDataStream &s,
+                              int v)
+{
+    s << qint32(v);
+}
+
+void BinaryProjectWriter::put(QDataStream &s,
+                              const Cfg::Point &c)
+{
+    put(s, double(c.x()));
+    put(s, double(c.y()));
+}
+
+void BinaryProjectWriter::put(QDataStream &s,
+                              const Cfg::Size &c)
+{
+    put(s, double(c.width()));
+    put(s, double(c.height()));
+}
+
+void BinaryProjectWriter::put(QDataStream &s,
+                              const Cfg::Pen &c)
+{
+    put(s, double(c.width()));
+    put(s, c.color());
+}
+
+void BinaryProjectWriter::put(QDataStream &s,
+                              const Cfg::Brush &c)
+{
+    put(s, c.color());
+}
+
+void BinaryProjectWriter::put(QDataStream &s,
+                              const Cfg::TextStyle &c)
+{
+    put(s, c.style());
+    put(s, double(c.fontSize()));
+    put(s, c.text());
+    put(s, c.link());
+}
+
+void BinaryProjectWriter::put(QDataStream &s,
+                              const Cfg::Comment &c)
+{
+    put(s, c.author());
+    put(s, c.text());
+}
+
+void BinaryProjectWriter::put(QDataStream &s,
+                              const Cfg::Comments &c)
+{
+    put(s, c.comment());
+    put(s, c.pos());
+    put(s, int(c.id()));
+}
+
+void BinaryProjectWriter::put(QDataStream &s,
+                              const Cfg::Line &c)
+{
+    put(s, c.p1());
+    put(s, c.p2());
+    put(s, c.pos());
+    put(s, c.objectId());
+    put(s, c.pen());
+    put(s, double(c.z()));
+}
+
+void BinaryProjectWriter::put(QDataStream &s,
+                              const Cfg::Polyline &c)
+{
+    put(s, c.line());
+    put(s, c.pos());
+    put(s, c.objectId());
+    put(s, c.pen());
+    put(s, c.brush());
+    put(s, c.size());
+    put(s, double(c.z()));
+}
+
+void BinaryProjectWriter::put(QDataStream &s,
+                              const Cfg::Text &c)
+{
+    put(s, c.text());
+    put(s, c.pos());
+    put(s, double(c.textWidth()));
+    put(s, c.objectId());
+    put(s, double(c.z()));
+    put(s, c.color());
+}
+
+void BinaryProjectWriter::put(QDataStream &s,
+                              const Cfg::Image &c)
+{
+    put(s, c.sha256());
+    s << QByteArray::fromBase64(c.data().toLatin1());
+    put(s, c.keepAspectRatio());
+    put(s, c.size());
+    put(s, c.pos());
+    put(s, c.objectId());
+    put(s, double(c.z()));
+}
+
+void BinaryProjectWriter::put(QDataStream &s,
+                              const Cfg::Rect &c)
+{
+    put(s, c.topLeft());
+    put(s, c.size());
+    put(s, c.pos());
+    put(s, c.objectId());
+    put(s, c.pen());
+    put(s, c.brush());
+    put(s, double(c.z()));
+}
+
+void BinaryProjectWriter::put(QDataStream &s,
+                              const Cfg::Button &c)
+{
+    putWithText(s, c);
+}
+
+void BinaryProjectWriter::put(QDataStream &s,
+                              const Cfg::CheckBox &c)
+{
+    putWithText(s, c);
+    put(s, double(c.width()));
+    put(s, c.isChecked());
+}
+
+void BinaryProjectWriter::put(QDataStream &s,
+                              const Cfg::ComboBox &c)
+{
+    putPlain(s, c);
+}
+
+void BinaryProjectWriter::put(QDataStream &s,
+                              const Cfg::SpinBox &c)
+{
+    putWithText(s, c);
+}
+
+void BinaryProjectWriter::put(QDataStream &s,
+                              const Cfg::HSlider &c)
+{
+    putPlain(s, c);
+}
+
+void BinaryProjectWriter::put(QDataStream &s,
+                              const Cfg::VSlider &c)
+{
+    putPlain(s, c);
+}
+
+void BinaryProjectWriter::put(QDataStream &s,
+                              const Cfg::Group &c)
+{
+    put(s, c.objectId());
+    put(s, c.line());
+    put(s, c.polyline());
+    put(s, c.text());
+    put(s, c.image());
+    put(s, c.rect());
+    put(s, c.button());
+    put(s, c.checkbox());
+    put(s, c.radiobutton());
+    put(s, c.combobox());
+    put(s, c.spinbox());
+    put(s, c.hslider());
+    put(s, c.vslider());
+    put(s, c.group());
+    put(s, c.pos());
+    put(s, double(c.z()));
+}
+
+void BinaryProjectWriter::put(QDataStream &s,
+                              const Cfg::Page &c)
+{
+    put(s, c.size());
+    put(s, double(c.gridStep()));
+    put(s, c.tabName());
+    put(s, c.line());
+    put(s, c.polyline());
+    put(s, c.text());
+    put(s, c.image());
+    put(s, c.rect());
+    put(s, c.group());
+    put(s, c.button());
+    put(s, c.checkbox());
+    put(s, c.radiobutton());
+    put(s, c.combobox());
+    put(s, c.spinbox());
+    put(s, c.hslider());
+    put(s, c.vslider());
+    put(s, c.comments());
+}
+
+void BinaryProjectWriter::put(QDataStream &s,
+                              const Cfg::ProjectDesc &c)
+{
+    put(s, c.text());
+    put(s, c.tabName());
+}
+
+//
+// BinaryProjectReader
+//
+
+//! Reader of the binary project.
+class BinaryProjectReader final
+{
+public:
+    BinaryProjectReader() = default;
+
+    //! Read project.
+    Cfg::Project read(QIODevice &device);
+    //! Read page from the chunk at the given offset.
+    Cfg::Page readPage(QIODevice &device,
+                       qint64 offset);
+
+private:
+    //! Throw on broken stream.
+    static void check(const QDataStream &s);
+    //! Read table of strings.
+    void readStrings(QDataStream &s);
+
+    QString string(QDataStream &s);
+    double real(QDataStream &s);
+    bool boolean(QDataStream &s);
+    int integer(QDataStream &s);
+
+    void get(QDataStream &s,
+             QString &v);
+    void get(QDataStream &s,
+             Cfg::Point &c);
+    void get(QDataStream &s,
+             Cfg::Size &c);
+    void get(QDataStream &s,
+             Cfg::Pen &c);
+    void get(QDataStream &s,
+             Cfg::Brush &c);
+    void get(QDataStream &s,
+             Cfg::TextStyle &c);
+    void get(QDataStream &s,
+             Cfg::Comment &c);
+    void get(QDataStream &s,
+             Cfg::Comments &c);
+    void get(QDataStream &s,
+             Cfg::Line &c);
+    void get(QDataStream &s,
+             Cfg::Polyline &c);
+    void get(QDataStream &s,
+             Cfg::Text &c);
+    void get(QDataStream &s,
+             Cfg::Image &c);
+    void get(QDataStream &s,
+             Cfg::Rect &c);
+    void get(QDataStream &s,
+             Cfg::Button &c);
+    void get(QDataStream &s,
+             Cfg::CheckBox &c);
+    void get(QDataStream &s,
+             Cfg::ComboBox &c);
+    void get(QDataStream &s,
+             Cfg::SpinBox &c);
+    void get(QDataStream &s,
+             Cfg::HSlider &c);
+    void get(QDataStream &s,
+             Cfg::VSlider &c);
+    void get(QDataStream &s,
+             Cfg::Group &c);
+    void get(QDataStream &s,
+             Cfg::Page &c);
+    void get(QDataStream &s,
+             Cfg::ProjectDesc &c);
+
+    //! Read vector.
+    template<typename T>
+    void get(QDataStream &s,
+             std::vector<T> &v)
+    {
+        quint32 count = 0;
+        s >> count;
+
+        v.clear();
+
+        for (quint32 i = 0; i < count; ++i) {
+            check(s);
+
+            T e;
+            get(s, e);
+
+            v.push_back(e);
+        }
+    }
+
+    //! Read element with pos, size, pen and brush.
+    template<typename T>
+    void getPlain(QDataStream &s,
+                  T &c)
+    {
+        get(s, c.pos());
+        get(s, c.size());
+        get(s, c.pen());
+        get(s, c.brush());
+        c.set_objectId(string(s));
+        c.set_z(real(s));
+    }
+
+    //! Read element with text, pos, size, pen and brush.
+    template<typename T>
+    void getWithText(QDataStream &s,
+                     T &c)
+    {
+        get(s, c.text());
+        getPlain(s, c);
+    }
+
+private:
+    //! Strings.
+    QVector<QString> m_strings;
+}; // class BinaryProjectReader
+
+Cfg::Project BinaryProjectReader::read(QIODevice &device)
+{
+    QDataStream in(&device);
+    setupStream(in);
+
+    readHeader(in);
+
+    Cfg::Project cfg;
+
+    while (true) {
+        quint32 id = 0;
+
+        const QByteArray payload = readChunk(in, id);
+
+        QDataStream s(payload);
+        setupStream(s);
+
+        switch (id) {
+        case c_stringsChunk: {
+            readStrings(s);
+        } break;
+
+        case c_projectChunk: {
+            get(s, cfg.description());
+            cfg.set_defaultGridStep(real(s));
+            cfg.set_showGrid(boolean(s));
+
+            // Written since precision was added.
+            if (!s.atEnd()) {
+                cfg.set_precision(real(s));
+            }
+        } break;
+
+        case c_pageChunk: {
+            Cfg::Page page;
+            get(s, page);
+
+            cfg.page().push_back(page);
+        } break;
+
+        case c_imageChunk: {
+            Cfg::ImageData image;
+            image.set_sha256(string(s));
+            image.set_format(string(s));
+
+            QByteArray data;
+            s >> data;
+
+            image.set_data(QString::fromLatin1(data.toBase64()));
+
+            cfg.images().push_back(image);
+        } break;
+
+        case c_endChunk:
+            return cfg;
+
+        default:
+            break;
+        }
+
+        check(s);
+    }
+}
+
+Cfg::Page BinaryProjectReader::readPage(QIODevice &device,
+                                        qint64 offset)
+{
+    QDataStream in(&device);
+    setupStream(in);
+
+    readHeader(in);
+
+    // Index is followed by the table of strings.
+    for (int i = 0; i < 2 && m_strings.isEmpty(); ++i) {
+        quint32 id = 0;
+
+        const QByteArray payload = readChunk(in, id);
+
+        if (id == c_stringsChunk) {
+            QDataStream s(payload);
+            setupStream(s);
+
+            readStrings(s);
+        }
+    }
+
+    if (!device.seek(offset)) {
+        throw ProjectFileException(QObject::tr("Binary project is truncated."));
+    }
+
+    quint32 id = 0;
+
+    const QByteArray payload = readChunk(in, id);
+
+    if (id != c_pageChunk) {
+        throw ProjectFileException(QObject::tr("Index of the binary project is corrupted."));
+    }
+
+    QDataStream s(payload);
+    setupStream(s);
+
+    Cfg::Page page;
+    get(s, page);
+
+    check(s);
+
+    return page;
+}
+
+void BinaryProjectReader::check(const QDataStream &s)
+{
+    if (s.status() != QDataStream::Ok) {
+        throw ProjectFileException(QObject::tr("Binary project is corrupted."));
+    }
+}
+
+void BinaryProjectReader::readStrings(QDataStream &s)
+{
+    quint32 count = 0;
+    s >> count;
+
+    m_strings.clear();
+
+    for (quint32 i = 0; i < count; ++i) {
+        check(s);
+
+        QString str;
+        s >> str;
+
+        m_strings.append(str);
+    }
+}
+
+QString BinaryProjectReader::string(QDataStream &s)
+{
+    quint32 idx = 0;
+    s >> idx;
+
+    check(s);
+
+    if (idx >= quint32(m_strings.size())) {
+        throw ProjectFileException(QObject::tr("Binary project is corrupted."));
+    }
+
+    return m_strings.at(idx);
+}
+
+double BinaryProjectReader::real(QDataStream &s)
+{
+    double v = 0.0;
+    s >> v;
+
+    return v;
+}
+
+bool BinaryProjectReader::boolean(QDataStream &s)
+{
+    bool v = false;
+    s >> v;
+
+    return v;
+}
+
+int BinaryProjectReader::integer(QDataStream &s)
+{
+    qint32 v = 0;
+    s >> v;
+
+    return v;
+}
+
+void BinaryProjectReader::get(QDataStream &s,
+                              QString &v)
+{
+    v = string(s);
+}
+
+void BinaryProjectReader::get(QDataStream &s,
+                              Cfg::Point &c)
+{
+    c.set_x(real(s));
+    c.set_y(real(s));
+}
+
+void BinaryProjectReader::get(QDataStream &s,
+                              Cfg::Size &c)
+{
+    c.set_width(real(s));
+    c.set_height(real(s));
+}
+
+void BinaryProjectReader::get(QDataStream &s,
+                              Cfg::Pen &c)
+{
+    c.set_width(real(s));
+    c.set_color(string(s));
+}
+
+void BinaryProjectReader::get(QDataStream &s,
+                              Cfg::Brush &c)
+{
+    c.set_color(string(s));
+}
+
+void BinaryProjectReader::get(QDataStream &s,
+                              Cfg::TextStyle &c)
+{
+    get(s, c.style());
+    c.set_fontSize(real(s));
+    c.set_text(string(s));
+    c.set_link(string(s));
+}
+
+void BinaryProjectReader::get(QDataStream &s,
+                              Cfg::Comment &c)
+{
+    c.set_author(string(s));
+    c.set_text(string(s));
+}
+
+void BinaryProjectReader::get(QDataStream &s,
+                              Cfg::Comments &c)
+{
+    get(s, c.comment());
+    get(s, c.pos());
+    c.set_id(integer(s));
+}
+
+void BinaryProjectReader::get(QDataStream &s,
+                              Cfg::Line &c)
+{
+    get(s, c.p1());
+    get(s, c.p2());
+    get(s, c.pos());
+    c.set_objectId(string(s));
+    get(s, c.pen());
+    c.set_z(real(s));
+}
+
+void BinaryProjectReader::get(QDataStream &s,
+                              Cfg::Polyline &c)
+{
+    get(s, c.line());
+    get(s, c.pos());
+    c.set_objectId(string(s));
+    get(s, c.pen());
+    get(s, c.brush());
+    get(s, c.size());
+    c.set_z(real(s));
+}
+
+void BinaryProjectReader::get(QDataStream &s,
+                              Cfg::Text &c)
+{
+    get(s, c.text());
+    get(s, c.pos());
+    c.set_textWidth(real(s));
+    c.set_objectId(string(s));
+    c.set_z(real(s));
+    c.set_color(string(s));
+}
+
+void BinaryProjectReader::get(QDataStream &s,
+                              Cfg::Image &c)
+{
+    c.set_sha256(string(s));
+
+    QByteArray data;
+    s >> data;
+
+    c.set_data(QString::fromLatin1(data.toBase64()));
+    c.set_keepAspectRatio(boolean(s));
+    get(s, c.size());
+    get(s, c.pos());
+    c.set_objectId(string(s));
+    c.set_z(real(s));
+}
+
+void BinaryProjectReader::get(QDataStream &s,
+                              Cfg::Rect &c)
+{
+    get(s, c.topLeft());
+    get(s, c.size());
+    get(s, c.pos());
+    c.set_objectId(string(s));
+    get(s, c.pen());
+    get(s, c.brush());
+    c.set_z(real(s));
+}
+
+void BinaryProjectReader::get(QDataStream &s,
+                              Cfg::Button &c)
+{
+    getWithText(s, c);
+}
+
+void BinaryProjectReader::get(QDataStream &s,
+                              Cfg::CheckBox &c)
+{
+    getWithText(s, c);
+    c.set_width(real(s));
+    c.set_isChecked(boolean(s));
+}
+
+void BinaryProjectReader::get(QDataStream &s,
+                              Cfg::ComboBox &c)
+{
+    getPlain(s, c);
+}
+
+void BinaryProjectReader::get(QDataStream &s,
+                              Cfg::SpinBox &c)
+{
+    getWithText(s, c);
+}
+
+void BinaryProjectReader::get(QDataStream &s,
+                              Cfg::HSlider &c)
+{
+    getPlain(s, c);
+}
+
+void BinaryProjectReader::get(QDataStream &s,
+                              Cfg::VSlider &c)
+{
+    getPlain(s, c);
+}
+
+void BinaryProjectReader::get(QDataStream &s,
+                              Cfg::Group &c)
+{
+    c.set_objectId(string(s));
+    get(s, c.line());
+    get(s, c.polyline());
+    get(s, c.text());
+    get(s, c.image());
+    get(s, c.rect());
+    get(s, c.button());
+    get(s, c.checkbox());
+    get(s, c.radiobutton());
+    get(s, c.combobox());
+    get(s, c.spinbox());
+    get(s, c.hslider());
+    get(s, c.vslider());
+    get(s, c.group());
+    get(s, c.pos());
+    c.set_z(real(s));
+}
+
+void BinaryProjectReader::get(QDataStream &s,
+                              Cfg::Page &c)
+{
+    get(s, c.size());
+    c.set_gridStep(real(s));
+    c.set_tabName(string(s));
+    get(s, c.line());
+    get(s, c.polyline());
+    get(s, c.text());
+    get(s, c.image());
+    get(s, c.rect());
+    get(s, c.group());
+    get(s, c.button());
+    get(s, c.checkbox());
+    get(s, c.radiobutton());
+    get(s, c.combobox());
+    get(s, c.spinbox());
+    get(s, c.hslider());
+    get(s, c.vslider());
+    get(s, c.comments());
+}
+
+void BinaryProjectReader::get(QDataStream &s,
+                              Cfg::ProjectDesc &c)
+{
+    get(s, c.text());
+    c.set_tabName(string(s));
+}
+
+//
+// Binary project
+//
+
+int binaryProjectMagicSize()
+{
+    return c_binaryMagic.size();
+}
+
+bool isBinaryProject(const QByteArray &head)
+{
+    return head.startsWith(c_binaryMagic);
+}
+
+Cfg::Project readBinaryProject(QIODevice &device)
+{
+    BinaryProjectReader reader;
+
+    return reader.read(device);
+}
+
+bool readBinaryProjectIndex(QIODevice &device,
+                            ProjectIndex &index)
+{
+    QDataStream in(&device);
+    setupStream(in);
+
+    readHeader(in);
+
+    quint32 id = 0;
+    quint64 size = 0;
+    in >> id >> size;
+
+    if (in.status() != QDataStream::Ok || id != c_indexChunk) {
+        return false;
+    }
+
+    // The index is read as it goes, the rest of the file isn't touched.
+    quint32 count = 0;
+    in >> count;
+
+    index.m_pages.clear();
+
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        ProjectIndexPage page;
+        quint64 offset = 0;
+        quint64 pageSize = 0;
+        quint32 elements = 0;
+
+        in >> page.m_tabName >> offset >> pageSize >> elements >> page.m_thumbnail;
+
+        page.m_offset = qint64(offset);
+        page.m_size = qint64(pageSize);
+        page.m_elements = int(elements);
+
+        index.m_pages.push_back(page);
+    }
+
+    if (in.status() != QDataStream::Ok) {
+        throw ProjectFileException(QObject::tr("Index of the binary project is corrupted."));
+    }
+
+    return true;
+}
+
+Cfg::Page readBinaryProjectPage(QIODevice &device,
+                                qint64 offset)
+{
+    BinaryProjectReader reader;
+
+    return reader.readPage(device, offset);
+}
+
+void writeBinaryProject(const Cfg::Project &cfg,
+                        QIODevice &device,
+                        const ProjectIndex *index)
+{
+    BinaryProjectWriter writer;
+
+    writer.write(cfg, device, index);
+}
+
+} /* namespace Core */
+
+} /* namespace Prototyper */
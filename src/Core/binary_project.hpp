@@ -0,0 +1,83 @@
+
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#ifndef PROTOTYPER__CORE__BINARY_PROJECT_HPP__INCLUDED
+#define PROTOTYPER__CORE__BINARY_PROJECT_HPP__INCLUDED
+
+// Qt include.
+#include <QByteArray>
+
+QT_BEGIN_NAMESPACE
+class QIODevice;
+QT_END_NAMESPACE
+
+namespace Prototyper
+{
+
+namespace Core
+{
+
+namespace Cfg
+{
+
+class Project;
+class Page;
+
+} /* namespace Cfg */
+
+struct ProjectIndex;
+
+/*
+    Binary project is a header followed by chunks.
+
+    Header: magic "PRTB", quint16 version, quint16 flags.
+    Chunk: quint32 id, quint64 size of the payload, payload.
+
+    Chunks:
+        "TOC " - optional index, it's the first chunk, see project_index.hpp;
+        "STRS" - table of all strings, other chunks refer strings by index;
+        "PROJ" - description, default grid step, grid visibility and precision;
+        "PAGE" - one per page, packed records of the page's elements;
+        "IMAG" - one per image: sha256, format and raw encoded bytes;
+        "END " - end of the project.
+
+    Numbers are little-endian, reals are doubles. Unknown chunks are skipped.
+*/
+
+//! \return Size of the magic bytes.
+int binaryProjectMagicSize();
+
+//! \return Do the given first bytes of a file belong to a binary project?
+bool isBinaryProject(const QByteArray &head);
+
+//! Read binary project.
+//! \throw ProjectFileException on error.
+Cfg::Project readBinaryProject(QIODevice &device);
+
+//! Read index of the binary project, the device should be at the start.
+//! \return Has the project an index?
+//! \throw ProjectFileException on error.
+bool readBinaryProjectIndex(QIODevice &device,
+                            ProjectIndex &index);
+
+//! \return Page of the binary project from the chunk at the given offset.
+//! \throw ProjectFileException on error.
+Cfg::Page readBinaryProjectPage(QIODevice &device,
+                                qint64 offset);
+
+//! Write binary project.
+//! \param index Index to write at the head of the file, names, counts of
+//! elements and thumbnails are taken from it, offsets are filled.
+//! \throw ProjectFileException on error.
+void writeBinaryProject(const Cfg::Project &cfg,
+                        QIODevice &device,
+                        const ProjectIndex *index = nullptr);
+
+} /* namespace Core */
+
+} /* namespace Prototyper */
+
+#endif // PROTOTYPER__CORE__BINARY_PROJECT_HPP__INCLUDED
@@ -0,0 +1,336 @@
+
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// Prototyper include.
+#include "compressed_device.hpp"
+
+// Qt include.
+#include <QByteArray>
+#include <QObject>
+
+// C++ include.
+#include <limits>
+
+// zlib include.
+#include <zlib.h>
+
+namespace Prototyper
+{
+
+namespace Core
+{
+
+//! Size of the chunk passed to zlib at once.
+static const int c_chunkSize = 64 * 1024;
+
+//! Window bits for gzip header and trailer.
+static const int c_gzipWindowBits = 15 + 16;
+
+bool isCompressedStream(const QByteArray &head)
+{
+    return (head.size() >= 2 && quint8(head.at(0)) == 0x1F && quint8(head.at(1)) == 0x8B);
+}
+
+//
+// DeflateDevicePrivate
+//
+
+class DeflateDevicePrivate
+{
+public:
+    explicit DeflateDevicePrivate(QIODevice &sink)
+        : m_sink(sink)
+        , m_output(c_chunkSize, Qt::Uninitialized)
+        , m_isInitialized(false)
+        , m_isFinished(false)
+    {
+        m_stream.zalloc = Z_NULL;
+        m_stream.zfree = Z_NULL;
+        m_stream.opaque = Z_NULL;
+    }
+
+    ~DeflateDevicePrivate()
+    {
+        if (m_isInitialized) {
+            deflateEnd(&m_stream);
+        }
+    }
+
+    //! Run deflate over the pending input writing the output to the sink.
+    //! \return Success?
+    bool deflateInput(int flush);
+
+    //! Sink.
+    QIODevice &m_sink;
+    //! zlib stream.
+    z_stream m_stream;
+    //! Output buffer.
+    QByteArray m_output;
+    //! Is stream initialized?
+    bool m_isInitialized;
+    //! Was the end of the stream written?
+    bool m_isFinished;
+}; // class DeflateDevicePrivate
+
+bool DeflateDevicePrivate::deflateInput(int flush)
+{
+    int ret = Z_OK;
+
+    do {
+        m_stream.next_out = reinterpret_cast<Bytef *>(m_output.data());
+        m_stream.avail_out = uInt(m_output.size());
+
+        ret = deflate(&m_stream, flush);
+
+        if (ret == Z_STREAM_ERROR) {
+            return false;
+        }
+
+        const qint64 bytes = m_output.size() - m_stream.avail_out;
+
+        if (bytes > 0 && m_sink.write(m_output.constData(), bytes) != bytes) {
+            return false;
+        }
+    } while (m_stream.avail_out == 0 || (flush == Z_FINISH && ret != Z_STREAM_END));
+
+    return true;
+}
+
+//
+// DeflateDevice
+//
+
+DeflateDevice::DeflateDevice(QIODevice &sink)
+    : d(new DeflateDevicePrivate(sink))
+{
+}
+
+DeflateDevice::~DeflateDevice()
+{
+    if (isOpen()) {
+        close();
+    }
+}
+
+bool DeflateDevice::isSequential() const
+{
+    return true;
+}
+
+bool DeflateDevice::open(OpenMode mode)
+{
+    if ((mode & ReadOnly) || d->m_isInitialized) {
+        return false;
+    }
+
+    if (deflateInit2(&d->m_stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, c_gzipWindowBits, 8, Z_DEFAULT_STRATEGY)
+        != Z_OK) {
+        setErrorString(QObject::tr("Unable to initialize compression."));
+
+        return false;
+    }
+
+    d->m_isInitialized = true;
+
+    return QIODevice::open(mode | Unbuffered);
+}
+
+void DeflateDevice::close()
+{
+    finish();
+
+    QIODevice::close();
+}
+
+bool DeflateDevice::finish()
+{
+    if (!d->m_isInitialized) {
+        return false;
+    }
+
+    if (!d->m_isFinished) {
+        d->m_isFinished = true;
+
+        d->m_stream.next_in = Z_NULL;
+        d->m_stream.avail_in = 0;
+
+        if (!d->deflateInput(Z_FINISH)) {
+            setErrorString(d->m_sink.errorString());
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+qint64 DeflateDevice::readData(char *,
+                               qint64)
+{
+    return -1;
+}
+
+qint64 DeflateDevice::writeData(const char *data,
+                                qint64 size)
+{
+    if (d->m_isFinished) {
+        return -1;
+    }
+
+    qint64 written = 0;
+
+    // avail_in is 32-bit.
+    while (written < size) {
+        const qint64 bytes = qMin(size - written, qint64(std::numeric_limits<uInt>::max()));
+
+        d->m_stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data + written));
+        d->m_stream.avail_in = uInt(bytes);
+
+        if (!d->deflateInput(Z_NO_FLUSH)) {
+            setErrorString(d->m_sink.errorString());
+
+            return -1;
+        }
+
+        written += bytes;
+    }
+
+    return written;
+}
+
+//
+// InflateDevicePrivate
+//
+
+class InflateDevicePrivate
+{
+public:
+    explicit InflateDevicePrivate(QIODevice &source)
+        : m_source(source)
+        , m_input(c_chunkSize, Qt::Uninitialized)
+        , m_isInitialized(false)
+        , m_isFinished(false)
+    {
+        m_stream.zalloc = Z_NULL;
+        m_stream.zfree = Z_NULL;
+        m_stream.opaque = Z_NULL;
+        m_stream.next_in = Z_NULL;
+        m_stream.avail_in = 0;
+    }
+
+    ~InflateDevicePrivate()
+    {
+        if (m_isInitialized) {
+            inflateEnd(&m_stream);
+        }
+    }
+
+    //! Source.
+    QIODevice &m_source;
+    //! zlib stream.
+    z_stream m_stream;
+    //! Input buffer.
+    QByteArray m_input;
+    //! Is stream initialized?
+    bool m_isInitialized;
+    //! Was the end of the stream read?
+    bool m_isFinished;
+}; // class InflateDevicePrivate
+
+//
+// InflateDevice
+//
+
+InflateDevice::InflateDevice(QIODevice &source)
+    : d(new InflateDevicePrivate(source))
+{
+}
+
+InflateDevice::~InflateDevice() = default;
+
+bool InflateDevice::isSequential() const
+{
+    return true;
+}
+
+bool InflateDevice::atEnd() const
+{
+    // Sequential device is at end when nothing is buffered, it's not so
+    // till the end of the stream is read.
+    return (d->m_isFinished && QIODevice::atEnd());
+}
+
+bool InflateDevice::open(OpenMode mode)
+{
+    if ((mode & WriteOnly) || d->m_isInitialized) {
+        return false;
+    }
+
+    if (inflateInit2(&d->m_stream, c_gzipWindowBits) != Z_OK) {
+        setErrorString(QObject::tr("Unable to initialize decompression."));
+
+        return false;
+    }
+
+    d->m_isInitialized = true;
+
+    return QIODevice::open(mode);
+}
+
+qint64 InflateDevice::readData(char *data,
+                               qint64 maxSize)
+{
+    if (d->m_isFinished) {
+        return 0;
+    }
+
+    d->m_stream.next_out = reinterpret_cast<Bytef *>(data);
+    d->m_stream.avail_out = uInt(qMin(maxSize, qint64(std::numeric_limits<uInt>::max())));
+
+    const uInt requested = d->m_stream.avail_out;
+
+    while (d->m_stream.avail_out > 0 && !d->m_isFinished) {
+        if (d->m_stream.avail_in == 0) {
+            const qint64 bytes = d->m_source.read(d->m_input.data(), d->m_input.size());
+
+            if (bytes < 0) {
+                setErrorString(d->m_source.errorString());
+
+                return -1;
+            } else if (bytes == 0) {
+                setErrorString(QObject::tr("Compressed stream is truncated."));
+
+                return -1;
+            }
+
+            d->m_stream.next_in = reinterpret_cast<Bytef *>(d->m_input.data());
+            d->m_stream.avail_in = uInt(bytes);
+        }
+
+        const int ret = inflate(&d->m_stream, Z_NO_FLUSH);
+
+        if (ret == Z_STREAM_END) {
+            d->m_isFinished = true;
+        } else if (ret != Z_OK && ret != Z_BUF_ERROR) {
+            setErrorString(d->m_stream.msg ? QString::fromLatin1(d->m_stream.msg)
+                                           : QObject::tr("Compressed stream is corrupted."));
+
+            return -1;
+        }
+    }
+
+    return qint64(requested - d->m_stream.avail_out);
+}
+
+qint64 InflateDevice::writeData(const char *,
+                                qint64)
+{
+    return -1;
+}
+
+} /* namespace Core */
+
+} /* namespace Prototyper */
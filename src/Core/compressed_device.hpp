@@ -0,0 +1,94 @@
+
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#ifndef PROTOTYPER__CORE__COMPRESSED_DEVICE_HPP__INCLUDED
+#define PROTOTYPER__CORE__COMPRESSED_DEVICE_HPP__INCLUDED
+
+// Qt include.
+#include <QIODevice>
+
+// C++ include.
+#include <memory>
+
+namespace Prototyper
+{
+
+namespace Core
+{
+
+//! \return Do the given first bytes of a file belong to a gzip stream?
+bool isCompressedStream(const QByteArray &head);
+
+//
+// DeflateDevice
+//
+
+class DeflateDevicePrivate;
+
+//! Write-only device compressing data into gzip stream on the fly.
+class DeflateDevice final : public QIODevice
+{
+public:
+    explicit DeflateDevice(QIODevice &sink);
+    ~DeflateDevice() override;
+
+    bool isSequential() const override;
+
+    bool open(OpenMode mode) override;
+    //! Finish the stream and close.
+    void close() override;
+
+    //! Write the end of the stream, it's done on close too.
+    //! \return Were all the data written?
+    bool finish();
+
+protected:
+    qint64 readData(char *data,
+                    qint64 maxSize) override;
+    qint64 writeData(const char *data,
+                     qint64 size) override;
+
+private:
+    Q_DISABLE_COPY(DeflateDevice)
+
+    std::unique_ptr<DeflateDevicePrivate> d;
+}; // class DeflateDevice
+
+//
+// InflateDevice
+//
+
+class InflateDevicePrivate;
+
+//! Read-only device decompressing gzip stream on the fly.
+class InflateDevice final : public QIODevice
+{
+public:
+    explicit InflateDevice(QIODevice &source);
+    ~InflateDevice() override;
+
+    bool isSequential() const override;
+    bool atEnd() const override;
+
+    bool open(OpenMode mode) override;
+
+protected:
+    qint64 readData(char *data,
+                    qint64 maxSize) override;
+    qint64 writeData(const char *data,
+                     qint64 size) override;
+
+private:
+    Q_DISABLE_COPY(InflateDevice)
+
+    std::unique_ptr<InflateDevicePrivate> d;
+}; // class InflateDevice
+
+} /* namespace Core */
+
+} /* namespace Prototyper */
+
+#endif // PROTOTYPER__CORE__COMPRESSED_DEVICE_HPP__INCLUDED
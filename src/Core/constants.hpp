@@ -38,6 +38,13 @@ static const qreal c_a4Width = 210.0;
 static const qreal c_a4Height = 297.0;
 static const qreal c_linePenWidth = 2.0;
 static const qreal c_headerFontSize = 20.0;
+static const int c_defaultPagesMemoryBudget = 512;
+static const qint64 c_pageItemMemoryCost = 1024;
+static const int c_statusMessageTimeout = 3000;
+static const int c_pagesPerLoadingStep = 16;
+static const int c_journalInterval = 2000;
+static const qint64 c_journalCheckpointSize = 4 * 1024 * 1024;
+static const qreal c_minGridSpacing = 4.0;
 
 static const QColor c_textColor = Qt::black;
 static const QColor c_linkColor = QColor(33, 122, 255);
@@ -16,15 +16,18 @@
 #include "../form/utils.hpp"
 #include "../form/vslider.hpp"
 #include "exporter_private.hpp"
+#include "image_cache.hpp"
 
 // Qt include.
 #include <QAbstractTextDocumentLayout>
 #include <QPainter>
 #include <QSvgGenerator>
 #include <QTextDocument>
+#include <QThreadPool>
 
 // C++ include.
 #include <algorithm>
+#include <vector>
 
 namespace Prototyper
 {
@@ -43,8 +46,22 @@ ExporterPrivate::ExporterPrivate(const Cfg::Project &cfg,
 {
 }
 
+ExporterPrivate::~ExporterPrivate() = default;
+
 void ExporterPrivate::init()
 {
+    // MmPx reads geometry of the screen, so it should be created
+    // on the GUI thread before any page is rendered on the thread pool.
+    MmPx::instance();
+
+    m_font = QFont();
+}
+
+ImageCache &ExporterPrivate::resetImageCache()
+{
+    m_imageCache.reset(new ImageCache(q->images()));
+
+    return *m_imageCache;
 }
 
 namespace impl
@@ -267,223 +284,305 @@ static inline void drawVSlider(const Cfg::VSlider &vs,
     p.restore();
 }
 
-template<typename CFG>
-void draw(QPainter &p,
-          QSvgGenerator &svg,
-          const CFG &form,
-          qreal dpi,
-          const ImagesHash &images)
+static inline void drawText(const Cfg::Text &text,
+                            QPainter &p,
+                            qreal dpi,
+                            QPaintDevice &device)
 {
-    static const qreal c_minZDiff = 0.5;
-
-    std::list<qreal> z;
-
-    for (const Cfg::Group &group : form.group()) {
-        z.push_back(qRound(group.z()));
-    }
-
-    for (const Cfg::Line &line : form.line()) {
-        z.push_back(qRound(line.z()));
-    }
-
-    for (const Cfg::Polyline &poly : form.polyline()) {
-        z.push_back(qRound(poly.z()));
-    }
+    p.save();
 
-    for (const Cfg::Text &text : form.text()) {
-        z.push_back(qRound(text.z()));
-    }
+    QTextDocument doc;
+    doc.documentLayout()->setPaintDevice(&device);
+    doc.setTextWidth(MmPx::instance().fromMm(text.textWidth(), dpi));
 
-    for (const Cfg::Image &image : form.image()) {
-        z.push_back(qRound(image.z()));
-    }
+    Cfg::fillTextDocument(&doc, text.text(), dpi);
 
-    for (const Cfg::Rect &rect : form.rect()) {
-        z.push_back(qRound(rect.z()));
-    }
+    p.translate(MmPx::instance().fromMm(text.pos().x(), dpi), MmPx::instance().fromMm(text.pos().y(), dpi));
 
-    for (const Cfg::Button &btn : form.button()) {
-        z.push_back(qRound(btn.z()));
-    }
+    doc.drawContents(&p);
 
-    for (const Cfg::CheckBox &chk : form.checkbox()) {
-        z.push_back(qRound(chk.z()));
-    }
-
-    for (const Cfg::CheckBox &chk : form.radiobutton()) {
-        z.push_back(qRound(chk.z()));
-    }
-
-    for (const Cfg::ComboBox &cb : form.combobox()) {
-        z.push_back(qRound(cb.z()));
-    }
+    p.restore();
+}
 
-    for (const Cfg::SpinBox &s : form.spinbox()) {
-        z.push_back(qRound(s.z()));
-    }
+static inline void drawImage(const Cfg::Image &image,
+                             QPainter &p,
+                             qreal dpi,
+                             ImageCache &images)
+{
+    const QSize s(MmPx::instance().fromMm(image.size().width(), dpi),
+                  MmPx::instance().fromMm(image.size().height(), dpi));
+
+    p.drawImage(MmPx::instance().fromMm(image.pos().x(), dpi),
+                MmPx::instance().fromMm(image.pos().y(), dpi),
+                images.image(image.sha256(),
+                             s,
+                             (image.keepAspectRatio() ? Qt::KeepAspectRatio : Qt::IgnoreAspectRatio)));
+}
 
-    for (const Cfg::HSlider &hs : form.hslider()) {
-        z.push_back(qRound(hs.z()));
-    }
+//
+// DrawItem
+//
 
-    for (const Cfg::VSlider &vs : form.vslider()) {
-        z.push_back(qRound(vs.z()));
+//! Element of the flat draw list of a page or a group.
+struct DrawItem {
+    //! Type of the element.
+    enum Type {
+        LineItem,
+        PolylineItem,
+        TextItem,
+        ImageItem,
+        RectItem,
+        GroupItem,
+        ButtonItem,
+        ComboBoxItem,
+        RadioButtonItem,
+        CheckBoxItem,
+        HSliderItem,
+        VSliderItem,
+        SpinBoxItem
+    }; // enum Type
+
+    //! Z-value.
+    qreal m_z;
+    //! Type.
+    Type m_type;
+    //! Index of the element in the vector of the given type.
+    std::size_t m_index;
+}; // struct DrawItem
+
+template<typename T>
+void appendDrawItems(std::vector<DrawItem> &list,
+                     const std::vector<T> &elems,
+                     DrawItem::Type type)
+{
+    for (std::size_t i = 0; i < elems.size(); ++i) {
+        list.push_back({elems[i].z(), type, i});
     }
+}
 
-    z.sort();
-    auto last = std::unique(z.begin(), z.end());
-    z.erase(last, z.end());
-
-    while (!z.empty()) {
-        const auto zv = z.front();
-
-        for (const Cfg::Group &group : form.group()) {
-            if (qAbs(zv - group.z()) < c_minZDiff) {
-                drawGroup(group, p, dpi, svg, images);
-            }
-        }
-
-        for (const Cfg::Line &line : form.line()) {
-            if (qAbs(zv - line.z()) < c_minZDiff) {
-                drawLine(line, p, dpi);
-            }
-        }
-
-        for (const Cfg::Polyline &poly : form.polyline()) {
-            if (qAbs(zv - poly.z()) < c_minZDiff) {
-                drawPolyline(poly, p, dpi);
-            }
-        }
+//! \return Flat list of elements sorted by Z-value.
+//! Elements with equal Z-value keep the order in which Page and FormGroup
+//! create them, i.e. the stacking order of the scene.
+template<typename CFG>
+std::vector<DrawItem> drawList(const CFG &form)
+{
+    std::vector<DrawItem> list;
+
+    list.reserve(form.line().size()
+                 + form.polyline().size()
+                 + form.text().size()
+                 + form.image().size()
+                 + form.rect().size()
+                 + form.group().size()
+                 + form.button().size()
+                 + form.combobox().size()
+                 + form.radiobutton().size()
+                 + form.checkbox().size()
+                 + form.hslider().size()
+                 + form.vslider().size()
+                 + form.spinbox().size());
+
+    appendDrawItems(list, form.line(), DrawItem::LineItem);
+    appendDrawItems(list, form.polyline(), DrawItem::PolylineItem);
+    appendDrawItems(list, form.text(), DrawItem::TextItem);
+    appendDrawItems(list, form.image(), DrawItem::ImageItem);
+    appendDrawItems(list, form.rect(), DrawItem::RectItem);
+    appendDrawItems(list, form.group(), DrawItem::GroupItem);
+    appendDrawItems(list, form.button(), DrawItem::ButtonItem);
+    appendDrawItems(list, form.combobox(), DrawItem::ComboBoxItem);
+    appendDrawItems(list, form.radiobutton(), DrawItem::RadioButtonItem);
+    appendDrawItems(list, form.checkbox(), DrawItem::CheckBoxItem);
+    appendDrawItems(list, form.hslider(), DrawItem::HSliderItem);
+    appendDrawItems(list, form.vslider(), DrawItem::VSliderItem);
+    appendDrawItems(list, form.spinbox(), DrawItem::SpinBoxItem);
+
+    std::stable_sort(list.begin(), list.end(), [](const DrawItem &i1, const DrawItem &i2) {
+        return (i1.m_z < i2.m_z);
+    });
+
+    return list;
+}
 
-        for (const Cfg::Text &text : form.text()) {
-            if (qAbs(zv - text.z()) < c_minZDiff) {
-                p.save();
+template<typename CFG>
+void draw(QPainter &p,
+          QPaintDevice &device,
+          const CFG &form,
+          qreal dpi,
+          ImageCache &images)
+{
+    const auto list = drawList(form);
 
-                QTextDocument doc;
-                doc.documentLayout()->setPaintDevice(&svg);
-                doc.setTextWidth(MmPx::instance().fromMm(text.textWidth(), dpi));
+    for (const DrawItem &item : list) {
+        switch (item.m_type) {
+        case DrawItem::LineItem: {
+            drawLine(form.line()[item.m_index], p, dpi);
+        } break;
 
-                Cfg::fillTextDocument(&doc, text.text(), dpi);
+        case DrawItem::PolylineItem: {
+            drawPolyline(form.polyline()[item.m_index], p, dpi);
+        } break;
 
-                p.translate(MmPx::instance().fromMm(text.pos().x(), dpi), MmPx::instance().fromMm(text.pos().y(), dpi));
+        case DrawItem::TextItem: {
+            drawText(form.text()[item.m_index], p, dpi, device);
+        } break;
 
-                doc.drawContents(&p);
+        case DrawItem::ImageItem: {
+            drawImage(form.image()[item.m_index], p, dpi, images);
+        } break;
 
-                p.restore();
-            }
-        }
+        case DrawItem::RectItem: {
+            drawRect(form.rect()[item.m_index], p, dpi);
+        } break;
 
-        for (const Cfg::Image &image : form.image()) {
-            if (qAbs(zv - image.z()) < c_minZDiff) {
-                const QSize s(MmPx::instance().fromMm(image.size().width(), dpi),
-                              MmPx::instance().fromMm(image.size().height(), dpi));
+        case DrawItem::GroupItem: {
+            drawGroup(form.group()[item.m_index], p, dpi, device, images);
+        } break;
 
-                const QByteArray data = QByteArray::fromBase64(images[image.sha256()].data().toLatin1());
+        case DrawItem::ButtonItem: {
+            drawButton(form.button()[item.m_index], p, dpi);
+        } break;
 
-                QImage img = QImage::fromData(data, "PNG");
+        case DrawItem::ComboBoxItem: {
+            drawComboBox(form.combobox()[item.m_index], p, dpi);
+        } break;
 
-                p.drawImage(MmPx::instance().fromMm(image.pos().x(), dpi),
-                            MmPx::instance().fromMm(image.pos().y(), dpi),
-                            img.scaled(s,
-                                       (image.keepAspectRatio() ? Qt::KeepAspectRatio : Qt::IgnoreAspectRatio),
-                                       Qt::SmoothTransformation));
-            }
-        }
+        case DrawItem::RadioButtonItem: {
+            drawRadioButton(form.radiobutton()[item.m_index], p, dpi);
+        } break;
 
-        for (const Cfg::Rect &rect : form.rect()) {
-            if (qAbs(zv - rect.z()) < c_minZDiff) {
-                drawRect(rect, p, dpi);
-            }
-        }
+        case DrawItem::CheckBoxItem: {
+            drawCheckBox(form.checkbox()[item.m_index], p, dpi);
+        } break;
 
-        for (const Cfg::Button &btn : form.button()) {
-            if (qAbs(zv - btn.z()) < c_minZDiff) {
-                drawButton(btn, p, dpi);
-            }
-        }
+        case DrawItem::HSliderItem: {
+            drawHSlider(form.hslider()[item.m_index], p, dpi);
+        } break;
 
-        for (const Cfg::CheckBox &chk : form.checkbox()) {
-            if (qAbs(zv - chk.z()) < c_minZDiff) {
-                drawCheckBox(chk, p, dpi);
-            }
-        }
+        case DrawItem::VSliderItem: {
+            drawVSlider(form.vslider()[item.m_index], p, dpi);
+        } break;
 
-        for (const Cfg::CheckBox &chk : form.radiobutton()) {
-            if (qAbs(zv - chk.z()) < c_minZDiff) {
-                drawRadioButton(chk, p, dpi);
-            }
-        }
+        case DrawItem::SpinBoxItem: {
+            drawSpinBox(form.spinbox()[item.m_index], p, dpi);
+        } break;
 
-        for (const Cfg::ComboBox &cb : form.combobox()) {
-            if (qAbs(zv - cb.z()) < c_minZDiff) {
-                drawComboBox(cb, p, dpi);
-            }
+        default:
+            break;
         }
-
-        for (const Cfg::SpinBox &s : form.spinbox()) {
-            if (qAbs(zv - s.z()) < c_minZDiff) {
-                drawSpinBox(s, p, dpi);
-            }
-        }
-
-        for (const Cfg::HSlider &hs : form.hslider()) {
-            if (qAbs(zv - hs.z()) < c_minZDiff) {
-                drawHSlider(hs, p, dpi);
-            }
-        }
-
-        for (const Cfg::VSlider &vs : form.vslider()) {
-            if (qAbs(zv - vs.z()) < c_minZDiff) {
-                drawVSlider(vs, p, dpi);
-            }
-        }
-
-        z.pop_front();
     }
 }
 
 void drawGroup(const Cfg::Group &group,
                QPainter &p,
                qreal dpi,
-               QSvgGenerator &svg,
-               const ImagesHash &images)
+               QPaintDevice &device,
+               ImageCache &images)
 {
     p.save();
 
     p.translate(MmPx::instance().fromMm(group.pos().x(), dpi), MmPx::instance().fromMm(group.pos().y(), dpi));
 
-    draw(p, svg, group, dpi, images);
+    draw(p, device, group, dpi, images);
 
     p.restore();
 }
 
 } /* namespace impl */
 
+QRect ExporterPrivate::viewBox(const Cfg::Page &form,
+                               qreal dpi)
+{
+    return QRect(-1,
+                 0,
+                 qRound(MmPx::instance().fromMm(form.size().width(), dpi)) + 1,
+                 qRound(MmPx::instance().fromMm(form.size().height(), dpi)));
+}
+
+void ExporterPrivate::drawPage(QPainter &p,
+                               QPaintDevice &device,
+                               const Cfg::Page &form,
+                               qreal dpi,
+                               ImageCache &images)
+{
+    p.setFont(m_font);
+    p.setPen(Qt::gray);
+
+    Page::draw(&p,
+               MmPx::instance().fromMm(form.size().width(), dpi),
+               MmPx::instance().fromMm(form.size().height(), dpi),
+               0,
+               false);
+
+    impl::draw(p, device, form, dpi, images);
+}
+
 void ExporterPrivate::drawForm(QSvgGenerator &svg,
                                const Cfg::Page &form,
                                qreal dpi,
-                               const ImagesHash &images)
+                               ImageCache &images)
 {
-    svg.setViewBox(QRect(-1,
-                         0,
-                         qRound(MmPx::instance().fromMm(form.size().width(), dpi)) + 1,
-                         qRound(MmPx::instance().fromMm(form.size().height(), dpi))));
+    svg.setViewBox(viewBox(form, dpi));
     svg.setResolution(dpi);
 
     QPainter p;
     p.begin(&svg);
 
+    drawPage(p, svg, form, dpi, images);
+
+    p.end();
+}
+
+void ExporterPrivate::renderPages(const std::function<void(const Cfg::Page &form,
+                                                           int index)> &render)
+{
+    QThreadPool pool;
+
+    int i = 0;
+
+    for (const Cfg::Page &form : m_cfg.page()) {
+        pool.start([&render, &form, i]() {
+            render(form, i);
+        });
+
+        ++i;
+    }
+
+    pool.waitForDone();
+}
+
+//
+// renderPageThumbnail
+//
+
+QImage renderPageThumbnail(const Cfg::Page &form,
+                           ImageCache &images,
+                           int size)
+{
+    const qreal longest = qMax(form.size().width(), form.size().height());
+
+    if (longest <= 0.0 || size <= 0) {
+        return QImage();
+    }
+
+    const qreal dpi = size * c_mmInInch / longest;
+
+    QImage image(qMax(1, qRound(MmPx::instance().fromMm(form.size().width(), dpi))),
+                 qMax(1, qRound(MmPx::instance().fromMm(form.size().height(), dpi))),
+                 QImage::Format_RGB32);
+    image.fill(Qt::white);
+
+    QPainter p(&image);
     p.setPen(Qt::gray);
 
-    Page::draw(&p,
-               MmPx::instance().fromMm(form.size().width(), dpi),
-               MmPx::instance().fromMm(form.size().height(), dpi),
-               0,
-               false);
+    Page::draw(&p, image.width() - 1, image.height() - 1, 0, false);
+
+    p.setRenderHint(QPainter::Antialiasing);
 
-    impl::draw(p, svg, form, dpi, images);
+    impl::draw(p, image, form, dpi, images);
 
     p.end();
+
+    return image;
 }
 
 //
@@ -509,6 +608,16 @@ Exporter::Exporter(std::unique_ptr<ExporterPrivate> &&dd)
     d.swap(tmp);
 }
 
+int Exporter::imageCacheHits() const
+{
+    return (d->m_imageCache ? d->m_imageCache->hits() : 0);
+}
+
+int Exporter::imageCacheMisses() const
+{
+    return (d->m_imageCache ? d->m_imageCache->misses() : 0);
+}
+
 ImagesHash Exporter::images() const
 {
     ImagesHash images;
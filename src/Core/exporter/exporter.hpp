@@ -14,8 +14,11 @@
 #include "../types.hpp"
 #include "project_cfg.hpp"
 
+// Qt include.
+#include <QImage>
+
 QT_BEGIN_NAMESPACE
-class QSvgGenerator;
+class QPaintDevice;
 class QPainter;
 QT_END_NAMESPACE
 
@@ -26,6 +29,7 @@ namespace Core
 {
 
 class ExporterPrivate;
+class ImageCache;
 
 //
 // Exporter
@@ -44,6 +48,11 @@ public:
     //! \return Hash of images.
     ImagesHash images() const;
 
+    //! \return Count of images taken from the cache during the last export.
+    int imageCacheHits() const;
+    //! \return Count of images decoded or scaled during the last export.
+    int imageCacheMisses() const;
+
 protected:
     explicit Exporter(std::unique_ptr<ExporterPrivate> &&dd);
 
@@ -54,14 +63,20 @@ private:
     Q_DISABLE_COPY(Exporter)
 }; // class Exporter
 
+//! \return Page drawn into the image with the longest side of \a size pixels.
+//! Can be called from any thread.
+QImage renderPageThumbnail(const Cfg::Page &form,
+                           ImageCache &images,
+                           int size);
+
 namespace impl
 {
 
 void drawGroup(const Cfg::Group &group,
                QPainter &p,
                qreal dpi,
-               QSvgGenerator &svg,
-               const ImagesHash &images);
+               QPaintDevice &device,
+               ImageCache &images);
 
 } /* namespace impl */
 
@@ -11,8 +11,18 @@
 #include "../types.hpp"
 #include "project_cfg.hpp"
 
+// Qt include.
+#include <QFont>
+
+// C++ include.
+#include <functional>
+#include <memory>
+
 QT_BEGIN_NAMESPACE
 class QSvgGenerator;
+class QPainter;
+class QPaintDevice;
+class QRect;
 QT_END_NAMESPACE
 
 namespace Prototyper
@@ -22,6 +32,7 @@ namespace Core
 {
 
 class Exporter;
+class ImageCache;
 
 //
 // ExporterPrivate
@@ -32,20 +43,40 @@ class ExporterPrivate
 public:
     ExporterPrivate(const Cfg::Project &cfg,
                     Exporter *parent);
-    virtual ~ExporterPrivate() = default;
+    virtual ~ExporterPrivate();
 
     //! Init.
     virtual void init();
+    //! \return View box of the page.
+    static QRect viewBox(const Cfg::Page &form,
+                         qreal dpi);
+    //! Draw page with the given painter.
+    void drawPage(QPainter &p,
+                  QPaintDevice &device,
+                  const Cfg::Page &form,
+                  qreal dpi,
+                  ImageCache &images);
     //! Draw form.
     void drawForm(QSvgGenerator &svg,
                   const Cfg::Page &form,
                   qreal dpi,
-                  const ImagesHash &images);
+                  ImageCache &images);
+    //! Start new cache of images for the export run.
+    ImageCache &resetImageCache();
+    //! Render pages concurrently on the thread pool.
+    //! \a render is invoked once per page with its index and may be called
+    //! from any thread, results should be assembled in page order by the caller.
+    void renderPages(const std::function<void(const Cfg::Page &form,
+                                              int index)> &render);
 
     //! Parent.
     Exporter *q;
     //! Cfg.
     Cfg::Project m_cfg;
+    //! Font captured on the GUI thread for painters of worker threads.
+    QFont m_font;
+    //! Cache of images of the last export run.
+    std::unique_ptr<ImageCache> m_imageCache;
 }; // class ExporterPrivate
 
 } /* namespace Core */
@@ -9,6 +9,7 @@
 #include "../constants.hpp"
 #include "../form/utils.hpp"
 #include "exporter_private.hpp"
+#include "image_cache.hpp"
 
 // Qt include.
 #include <QBuffer>
@@ -17,6 +18,9 @@
 #include <QSvgGenerator>
 #include <QTextStream>
 
+// C++ include.
+#include <vector>
+
 namespace Prototyper
 {
 
@@ -106,7 +110,28 @@ void HtmlExporterPrivate::printDocument(QTextStream &stream)
 
     stream << QStringLiteral("<br><br>") << Qt::endl;
 
-    const auto imagesHash = q->images();
+    ImageCache &imagesCache = resetImageCache();
+
+    std::vector<QByteArray> images(m_cfg.page().size());
+
+    renderPages([&](const Cfg::Page &form, int i) {
+        QByteArray &data = images[i];
+        QBuffer buff(&data);
+        buff.open(QIODevice::WriteOnly);
+        QSvgGenerator svg;
+        svg.setResolution(c_resolution);
+        svg.setOutputDevice(&buff);
+
+        drawForm(svg, form, c_resolution, imagesCache);
+
+        const int idx = data.indexOf(QStringLiteral("\n").toLatin1());
+
+        if (idx != -1) {
+            data.remove(0, idx);
+        }
+    });
+
+    std::size_t i = 0;
 
     for (const Cfg::Page &form : m_cfg.page()) {
         std::vector<Cfg::TextStyle> headList;
@@ -122,22 +147,9 @@ void HtmlExporterPrivate::printDocument(QTextStream &stream)
 
         stream << QStringLiteral("</a>") << QStringLiteral("<br><br>");
 
-        QByteArray data;
-        QBuffer buff(&data);
-        buff.open(QIODevice::WriteOnly);
-        QSvgGenerator svg;
-        svg.setResolution(c_resolution);
-        svg.setOutputDevice(&buff);
-
-        drawForm(svg, form, c_resolution, imagesHash);
-
-        const int i = data.indexOf(QStringLiteral("\n").toLatin1());
-
-        if (i != -1) {
-            data.remove(0, i);
-        }
+        stream << QStringLiteral("<div>") << images[i] << QStringLiteral("</div><br>");
 
-        stream << QStringLiteral("<div>") << data << QStringLiteral("</div><br>");
+        ++i;
     }
 
     stream << QStringLiteral("</div></body>") << Qt::endl;
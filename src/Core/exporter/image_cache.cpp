@@ -0,0 +1,112 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// Prototyper include.
+#include "image_cache.hpp"
+
+// Qt include.
+#include <QByteArray>
+#include <QMutexLocker>
+
+namespace Prototyper
+{
+
+namespace Core
+{
+
+//
+// ImageCache
+//
+
+ImageCache::ImageCache(const ImagesHash &images)
+    : m_images(images)
+    , m_hits(0)
+    , m_misses(0)
+{
+}
+
+QImage ImageCache::image(const QString &sha256,
+                         const QSize &size,
+                         Qt::AspectRatioMode mode)
+{
+    const Key key = {sha256, size, mode};
+
+    std::promise<QImage> promise;
+    std::shared_future<QImage> future;
+    bool isFirst = false;
+
+    {
+        QMutexLocker lock(&m_mutex);
+
+        const auto it = m_scaled.constFind(key);
+
+        if (it != m_scaled.cend()) {
+            ++m_hits;
+
+            future = it.value();
+        } else {
+            ++m_misses;
+
+            isFirst = true;
+            future = promise.get_future().share();
+
+            m_scaled.insert(key, future);
+        }
+    }
+
+    // Scaling is done without the lock so pages on other threads are not blocked,
+    // threads asking for the same image wait for the first one.
+    if (isFirst) {
+        promise.set_value(decoded(sha256).scaled(size, mode, Qt::SmoothTransformation));
+    }
+
+    return future.get();
+}
+
+QImage ImageCache::decoded(const QString &sha256)
+{
+    std::promise<QImage> promise;
+    std::shared_future<QImage> future;
+    bool isFirst = false;
+
+    {
+        QMutexLocker lock(&m_mutex);
+
+        const auto it = m_decoded.constFind(sha256);
+
+        if (it != m_decoded.cend()) {
+            future = it.value();
+        } else {
+            isFirst = true;
+            future = promise.get_future().share();
+
+            m_decoded.insert(sha256, future);
+        }
+    }
+
+    if (isFirst) {
+        const Cfg::ImageData image = m_images.value(sha256);
+
+        const QByteArray data = QByteArray::fromBase64(image.data().toLatin1());
+
+        promise.set_value(QImage::fromData(data, image.format().toLatin1().constData()));
+    }
+
+    return future.get();
+}
+
+int ImageCache::hits() const
+{
+    return m_hits;
+}
+
+int ImageCache::misses() const
+{
+    return m_misses;
+}
+
+} /* namespace Core */
+
+} /* namespace Prototyper */
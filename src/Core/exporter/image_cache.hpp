@@ -0,0 +1,98 @@
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#ifndef PROTOTYPER__CORE__IMAGE_CACHE_HPP__INCLUDED
+#define PROTOTYPER__CORE__IMAGE_CACHE_HPP__INCLUDED
+
+// Qt include.
+#include <QHash>
+#include <QImage>
+#include <QMutex>
+#include <QSize>
+#include <QString>
+
+// C++ include.
+#include <atomic>
+#include <future>
+
+// Prototyper include.
+#include "../types.hpp"
+
+namespace Prototyper
+{
+
+namespace Core
+{
+
+//
+// ImageCache
+//
+
+//! Cache of decoded and scaled images for one export run.
+//! Can be used from the threads of the pool, each image is decoded
+//! and scaled once, other threads wait for it.
+class ImageCache final
+{
+public:
+    explicit ImageCache(const ImagesHash &images);
+    ~ImageCache() = default;
+
+    //! \return Image with the given SHA-256 scaled to the given size.
+    QImage image(const QString &sha256,
+                 const QSize &size,
+                 Qt::AspectRatioMode mode);
+
+    //! \return Count of requests served from the cache.
+    int hits() const;
+    //! \return Count of requests that required decoding or scaling.
+    int misses() const;
+
+private:
+    //! \return Decoded image with the given SHA-256.
+    QImage decoded(const QString &sha256);
+
+private:
+    Q_DISABLE_COPY(ImageCache)
+
+    //! Key of the scaled image.
+    struct Key {
+        //! SHA-256 of the image.
+        QString m_sha256;
+        //! Target size.
+        QSize m_size;
+        //! Aspect ratio mode.
+        Qt::AspectRatioMode m_mode;
+
+        bool operator==(const Key &other) const
+        {
+            return (m_sha256 == other.m_sha256 && m_size == other.m_size && m_mode == other.m_mode);
+        }
+    }; // struct Key
+
+    friend size_t qHash(const Key &key,
+                        size_t seed) noexcept
+    {
+        return qHashMulti(seed, key.m_sha256, key.m_size.width(), key.m_size.height(), static_cast<int>(key.m_mode));
+    }
+
+    //! Encoded images.
+    ImagesHash m_images;
+    //! Guard.
+    QMutex m_mutex;
+    //! Decoded images, ready or being decoded.
+    QHash<QString, std::shared_future<QImage>> m_decoded;
+    //! Scaled images, ready or being scaled.
+    QHash<Key, std::shared_future<QImage>> m_scaled;
+    //! Hits.
+    std::atomic<int> m_hits;
+    //! Misses.
+    std::atomic<int> m_misses;
+}; // class ImageCache
+
+} /* namespace Core */
+
+} /* namespace Prototyper */
+
+#endif // PROTOTYPER__CORE__IMAGE_CACHE_HPP__INCLUDED
@@ -9,17 +9,14 @@
 #include "../constants.hpp"
 #include "../form/utils.hpp"
 #include "exporter_private.hpp"
+#include "image_cache.hpp"
 
 // Qt include.
 #include <QAbstractTextDocumentLayout>
-#include <QList>
 #include <QPageLayout>
 #include <QPainter>
 #include <QPdfWriter>
-#include <QSharedPointer>
-#include <QSvgGenerator>
-#include <QSvgRenderer>
-#include <QTemporaryFile>
+#include <QRect>
 #include <QTextBlock>
 #include <QTextCursor>
 #include <QTextDocument>
@@ -34,6 +31,8 @@ namespace Core
 {
 
 static const int c_pageBreakType = QTextFormat::UserFormat + 1;
+static const int c_pageType = QTextFormat::UserFormat + 2;
+static const int c_pageIndexProperty = QTextFormat::UserProperty + 1;
 
 //
 // PdfExporterPrivate
@@ -49,8 +48,6 @@ public:
     {
     }
 
-    //! Create tmp images.
-    void createImages();
     //! Fill document.
     void fillDocument(QTextDocument &doc,
                       qreal dpi);
@@ -58,30 +55,8 @@ public:
     void printDocument(const QTextDocument &doc,
                        QPdfWriter &pdf,
                        const QRectF &body);
-
-    //! Images' files.
-    QList<QSharedPointer<QTemporaryFile>> m_images;
 }; // class PdfExporterPrivate
 
-void PdfExporterPrivate::createImages()
-{
-    const auto imagesHash = q->images();
-
-    for (const Cfg::Page &form : m_cfg.page()) {
-        m_images.append(QSharedPointer<QTemporaryFile>(new QTemporaryFile));
-
-        m_images.last()->open();
-
-        QSvgGenerator svg;
-        svg.setFileName(m_images.last()->fileName());
-        svg.setResolution(c_resolution);
-
-        drawForm(svg, form, c_resolution, imagesHash);
-
-        m_images.last()->close();
-    }
-}
-
 void PdfExporterPrivate::fillDocument(QTextDocument &doc,
                                       qreal dpi)
 {
@@ -115,13 +90,13 @@ void PdfExporterPrivate::fillDocument(QTextDocument &doc,
 
         c.movePosition(QTextCursor::End);
 
-        QTextImageFormat image;
-
-        image.setName(m_images.at(i)->fileName());
+        QTextCharFormat page;
+        page.setObjectType(c_pageType);
+        page.setProperty(c_pageIndexProperty, i);
 
         ++i;
 
-        c.insertImage(image);
+        c.insertText(QString(QChar::ObjectReplacementCharacter), page);
     }
 }
 
@@ -129,6 +104,8 @@ void PdfExporterPrivate::printDocument(const QTextDocument &doc,
                                        QPdfWriter &pdf,
                                        const QRectF &body)
 {
+    ImageCache &imagesCache = resetImageCache();
+
     QTextBlock block = doc.begin();
 
     QPainter p;
@@ -139,19 +116,19 @@ void PdfExporterPrivate::printDocument(const QTextDocument &doc,
     while (block.isValid()) {
         QTextBlock::Iterator it = block.begin();
 
-        QTextImageFormat imageFormat;
+        int pageIndex = -1;
 
-        bool isImage = false;
+        bool isPage = false;
         bool isBreak = false;
 
         for (; !it.atEnd(); ++it) {
             const QString txt = it.fragment().text();
             bool isObject = txt.contains(QChar::ObjectReplacementCharacter);
-            isImage = isObject && it.fragment().charFormat().isImageFormat();
+            isPage = isObject && (it.fragment().charFormat().objectType() == c_pageType);
             isBreak = isObject && (it.fragment().charFormat().objectType() == c_pageBreakType);
 
-            if (isImage) {
-                imageFormat = it.fragment().charFormat().toImageFormat();
+            if (isPage) {
+                pageIndex = it.fragment().charFormat().intProperty(c_pageIndexProperty);
             }
         }
 
@@ -159,9 +136,10 @@ void PdfExporterPrivate::printDocument(const QTextDocument &doc,
             pdf.newPage();
 
             y = 0.0;
-        } else if (isImage) {
-            QSvgRenderer svg(imageFormat.name());
-            QSize s = svg.viewBox().size();
+        } else if (isPage) {
+            const Cfg::Page &form = m_cfg.page().at(pageIndex);
+            const QRect box = viewBox(form, c_resolution);
+            QSize s = box.size();
 
             if (s.width() > body.size().width() || s.height() > body.size().height() - y) {
                 s.scale(QSize(qRound(body.size().width()), qRound(body.size().height() - y)), Qt::KeepAspectRatio);
@@ -176,8 +154,10 @@ void PdfExporterPrivate::printDocument(const QTextDocument &doc,
             p.save();
 
             p.translate((body.size().width() - s.width()) / 2, y);
+            p.scale(static_cast<qreal>(s.width()) / box.width(), static_cast<qreal>(s.height()) / box.height());
+            p.translate(-box.x(), -box.y());
 
-            svg.render(&p, QRectF(0, 0, s.width(), s.height()));
+            drawPage(p, pdf, form, c_resolution, imagesCache);
 
             y += s.height();
 
@@ -220,8 +200,6 @@ void PdfExporter::exportToDoc(const QString &fileName)
 {
     PdfExporterPrivate *d = d_ptr();
 
-    d->m_images.clear();
-
     QPdfWriter pdf(fileName);
 
     pdf.setResolution(c_resolution);
@@ -234,8 +212,6 @@ void PdfExporter::exportToDoc(const QString &fileName)
 
     const QRectF body(0, 0, pdf.width(), pdf.height());
 
-    d->createImages();
-
     QTextDocument doc;
     doc.documentLayout()->setPaintDevice(&pdf);
     doc.setPageSize(body.size());
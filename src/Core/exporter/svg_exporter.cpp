@@ -9,11 +9,13 @@
 #include "../constants.hpp"
 #include "../form/utils.hpp"
 #include "exporter_private.hpp"
+#include "image_cache.hpp"
 
 // Qt include.
 #include <QFile>
 #include <QPainter>
 #include <QSvgGenerator>
+#include <QStringList>
 #include <QSvgRenderer>
 
 namespace Prototyper
@@ -42,37 +44,33 @@ public:
 
 void SvgExporterPrivate::createImages(const QString &dir)
 {
-    const auto imagesHash = q->images();
+    ImageCache &imagesCache = resetImageCache();
 
-    int i = 1;
+    QStringList fileNames;
 
-    for (const Cfg::Page &form : m_cfg.page()) {
+    for (int i = 1; i <= static_cast<int>(m_cfg.page().size()); ++i) {
         const QString fileName = dir + QStringLiteral("/") + QString::number(i) + QStringLiteral(".svg");
 
         QFile file(fileName);
 
-        bool canModify = true;
-
         if (!file.open(QIODevice::WriteOnly)) {
-            canModify = false;
+            throw SvgExporterException(QObject::tr("Unable to export SVG into %1.\n"
+                                                   "File is not writable.")
+                                           .arg(fileName));
         }
 
         file.close();
 
-        if (canModify) {
-            QSvgGenerator svg;
-            svg.setFileName(fileName);
-            svg.setResolution(c_resolution);
+        fileNames.append(fileName);
+    }
 
-            drawForm(svg, form, c_resolution, imagesHash);
+    renderPages([&](const Cfg::Page &form, int i) {
+        QSvgGenerator svg;
+        svg.setFileName(fileNames.at(i));
+        svg.setResolution(c_resolution);
 
-            ++i;
-        } else {
-            throw SvgExporterException(QObject::tr("Unable to export SVG into %1.\n"
-                                                   "File is not writable.")
-                                           .arg(fileName));
-        }
-    }
+        drawForm(svg, form, c_resolution, imagesCache);
+    });
 }
 
 //
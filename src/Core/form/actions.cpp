@@ -32,6 +32,7 @@ public:
         , m_fillColor(Qt::transparent)
         , m_strokeColor(Qt::black)
         , m_snap(true)
+        , m_renderCache(false)
     {
     }
 
@@ -47,6 +48,8 @@ public:
     QColor m_strokeColor;
     //! Is snap enabled?
     bool m_snap;
+    //! Is render cache of widgets enabled?
+    bool m_renderCache;
     //! Flags.
     PageAction::Flags m_flags;
 }; // class FormActionPrivate
@@ -157,6 +160,22 @@ void PageAction::enableSnap(bool on)
     d->m_snap = on;
 }
 
+bool PageAction::isRenderCacheEnabled() const
+{
+    return d->m_renderCache;
+}
+
+void PageAction::enableRenderCache(bool on)
+{
+    d->m_renderCache = on;
+}
+
+QGraphicsItem::CacheMode PageAction::widgetCacheMode() const
+{
+    // Widgets are redrawn from the pixmap till update(), it's rendered again on zoom.
+    return (d->m_renderCache ? QGraphicsItem::DeviceCoordinateCache : QGraphicsItem::NoCache);
+}
+
 } /* namespace Core */
 
 } /*  namespace Prototyper */
@@ -9,6 +9,7 @@
 
 // Qt include.
 #include <QFlags>
+#include <QGraphicsItem>
 #include <QObject>
 
 // C++ include.
@@ -117,6 +118,13 @@ public:
     //! Enable/disable snap to grid.
     void enableSnap(bool on = true);
 
+    //! Is render cache of widgets enabled?
+    bool isRenderCacheEnabled() const;
+    //! Enable/disable render cache of widgets, it's used by widgets created after.
+    void enableRenderCache(bool on = true);
+    //! \return Cache mode for widgets.
+    QGraphicsItem::CacheMode widgetCacheMode() const;
+
 private:
     Q_DISABLE_COPY(PageAction)
 
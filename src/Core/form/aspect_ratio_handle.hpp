@@ -13,6 +13,9 @@
 // C++ include.
 #include <memory>
 
+// Prototyper include.
+#include "../types.hpp"
+
 namespace Prototyper
 {
 
@@ -32,6 +35,14 @@ public:
     explicit AspectRatioHandle(QGraphicsItem *parent);
     ~AspectRatioHandle() override;
 
+    //! Type of the graphics item.
+    enum { Type = AspectRatioHandleItemType };
+
+    int type() const override
+    {
+        return Type;
+    }
+
     //! \return Is keep aspect ratio?
     bool isKeepAspectRatio() const;
     //! Set keep aspect ratio.
@@ -98,10 +98,14 @@ void FormButtonPrivate::init()
     q->setObjectPen(QPen(PageAction::instance()->strokeColor()), false);
 
     q->setObjectBrush(QBrush(PageAction::instance()->fillColor()), false);
+
+    q->setCacheMode(PageAction::instance()->widgetCacheMode());
 }
 
 void FormButtonPrivate::setRect(const QRectF &rect)
 {
+    q->prepareGeometryChange();
+
     m_rect = rect;
 
     q->setPos(m_rect.topLeft());
@@ -338,6 +342,8 @@ void FormButton::resize(const QRectF &rect)
 {
     d->setRect(rect);
 
+    update();
+
     page()->update();
 }
 
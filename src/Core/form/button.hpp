@@ -49,6 +49,14 @@ public:
         return ButtonType;
     }
 
+    //! Type of the graphics item.
+    enum { Type = FormObjectItemType + ButtonType };
+
+    int type() const override
+    {
+        return Type;
+    }
+
     void paint(QPainter *painter,
                const QStyleOptionGraphicsItem *option,
                QWidget *widget = 0) override;
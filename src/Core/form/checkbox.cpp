@@ -71,10 +71,14 @@ void FormCheckBoxPrivate::init()
     q->setObjectPen(QPen(PageAction::instance()->strokeColor()), false);
 
     q->setObjectBrush(QBrush(PageAction::instance()->fillColor()), false);
+
+    q->setCacheMode(PageAction::instance()->widgetCacheMode());
 }
 
 void FormCheckBoxPrivate::setRect(const QRectF &rect)
 {
+    q->prepareGeometryChange();
+
     const QRectF r = rect;
 
     m_rect = QRectF(0.0, 0.0, FormCheckBox::boxHeight(), rect.height());
@@ -301,6 +305,9 @@ Cfg::TextStyle FormCheckBox::text() const
 
 void FormCheckBox::setText(const Cfg::TextStyle &c)
 {
+    // Height of the item depends on the font.
+    prepareGeometryChange();
+
     if (std::find(c.style().cbegin(), c.style().cend(), Cfg::c_normalStyle) != c.style().cend()) {
         d->m_font.setWeight(QFont::Normal);
         d->m_font.setItalic(false);
@@ -339,6 +346,8 @@ void FormCheckBox::setText(const Cfg::TextStyle &c)
         d->connectProperties();
     }
 
+    update();
+
     if (scene()) {
         scene()->update();
     }
@@ -403,6 +412,8 @@ void FormCheckBox::setRectangle(const QRectF &rect,
 
 void FormCheckBox::resize(const QRectF &rect)
 {
+    prepareGeometryChange();
+
     setPos(rect.topLeft());
 
     d->m_width = rect.width();
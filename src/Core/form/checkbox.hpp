@@ -51,6 +51,14 @@ public:
         return CheckBoxType;
     }
 
+    //! Type of the graphics item.
+    enum { Type = FormObjectItemType + CheckBoxType };
+
+    int type() const override
+    {
+        return Type;
+    }
+
     void paint(QPainter *painter,
                const QStyleOptionGraphicsItem *option,
                QWidget *widget = 0) Q_DECL_OVERRIDE;
@@ -134,7 +142,7 @@ protected:
     std::unique_ptr<FormCheckBoxPrivate> d;
 
 private:
-    friend class FormButtonPrivate;
+    friend class FormCheckBoxPrivate;
 
     Q_DISABLE_COPY(FormCheckBox)
 }; // class FormCheckBox
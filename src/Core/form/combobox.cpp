@@ -66,10 +66,14 @@ void FormComboBoxPrivate::init()
     q->setObjectPen(QPen(PageAction::instance()->strokeColor()), false);
 
     q->setObjectBrush(QBrush(PageAction::instance()->fillColor()), false);
+
+    q->setCacheMode(PageAction::instance()->widgetCacheMode());
 }
 
 void FormComboBoxPrivate::setRect(const QRectF &rect)
 {
+    q->prepareGeometryChange();
+
     m_rect = rect;
 
     q->setPos(m_rect.topLeft());
@@ -260,6 +264,8 @@ void FormComboBox::resize(const QRectF &rect)
 {
     d->setRect(rect);
 
+    update();
+
     page()->update();
 }
 
@@ -111,6 +111,8 @@ void PageComment::setCfg(const Cfg::Comments &c)
         d->m_comments.append(qMakePair(s.author(), s.text()));
     }
 
+    prepareGeometryChange();
+
     d->m_id = c.id();
 
     update();
@@ -128,6 +130,8 @@ void PageComment::setAuthor(const QString &name)
 
 void PageComment::setId(int id)
 {
+    prepareGeometryChange();
+
     d->m_id = id;
 
     scene()->update();
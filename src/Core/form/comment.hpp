@@ -14,6 +14,7 @@
 #include <memory>
 
 // Prototyper include.
+#include "../types.hpp"
 #include "project_cfg.hpp"
 
 namespace Prototyper
@@ -43,6 +44,14 @@ public:
     PageComment(QGraphicsItem *parent = nullptr);
     ~PageComment() override;
 
+    //! Type of the graphics item.
+    enum { Type = CommentItemType };
+
+    int type() const override
+    {
+        return Type;
+    }
+
     //! \return Cfg.
     Cfg::Comments cfg() const;
     //! Set cfg.
@@ -13,6 +13,9 @@
 // C++ include.
 #include <memory>
 
+// Prototyper include.
+#include "../types.hpp"
+
 namespace Prototyper
 {
 
@@ -32,6 +35,14 @@ public:
     explicit GridSnap(QGraphicsItem *parent);
     ~GridSnap() override;
 
+    //! Type of the graphics item.
+    enum { Type = GridSnapItemType };
+
+    int type() const override
+    {
+        return Type;
+    }
+
     //! \return Current position.
     const QPointF &snapPos() const;
     //! Set position, it will calculate snap position.
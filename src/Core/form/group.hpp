@@ -45,6 +45,10 @@ public:
         return GroupType;
     }
 
+    //! Type of the graphics item. It's the type of QGraphicsItemGroup, Qt
+    //! finds groups by it. There are no other groups on pages.
+    enum { Type = QGraphicsItemGroup::Type };
+
     //! \return Cfg.
     Cfg::Group cfg() const;
     //! Set cfg. \warning This group must be empty.
@@ -62,10 +62,14 @@ void FormHSliderPrivate::init()
     q->setObjectPen(QPen(PageAction::instance()->strokeColor()), false);
 
     q->setObjectBrush(Qt::transparent, false);
+
+    q->setCacheMode(PageAction::instance()->widgetCacheMode());
 }
 
 void FormHSliderPrivate::setRect(const QRectF &rect)
 {
+    q->prepareGeometryChange();
+
     m_rect = rect;
 
     q->setPos(m_rect.topLeft());
@@ -241,6 +245,8 @@ void FormHSlider::resize(const QRectF &rect)
 {
     d->setRect(rect);
 
+    update();
+
     page()->update();
 }
 
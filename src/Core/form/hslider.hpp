@@ -45,6 +45,14 @@ public:
         return HSliderType;
     }
 
+    //! Type of the graphics item.
+    enum { Type = FormObjectItemType + HSliderType };
+
+    int type() const override
+    {
+        return Type;
+    }
+
     void paint(QPainter *painter,
                const QStyleOptionGraphicsItem *option,
                QWidget *widget = 0) override;
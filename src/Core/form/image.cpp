@@ -7,6 +7,7 @@
 // Prototyper include.
 #include "image.hpp"
 #include "image_handles.hpp"
+#include "image_store.hpp"
 #include "page.hpp"
 #include "properties/object_properties.hpp"
 #include "properties/ui_object_properties.h"
@@ -14,12 +15,11 @@
 #include "utils.hpp"
 
 // Qt include.
-#include <QBuffer>
 #include <QByteArray>
-#include <QCryptographicHash>
 #include <QGraphicsScene>
 #include <QGraphicsSceneHoverEvent>
 #include <QGraphicsSceneMouseEvent>
+#include <QImageReader>
 #include <QUndoStack>
 #include <QVBoxLayout>
 
@@ -50,11 +50,13 @@ public:
     void disconnectProperties();
     //! \return Full image rect.
     QRectF imageRect() const;
+    //! \return Image.
+    const QImage &image() const;
 
     //! Parent.
     FormImage *q;
-    //! Image.
-    QImage m_image;
+    //! Image in the project's store, pinned while the item exists.
+    ImageHandle m_image;
     //! Handles.
     std::unique_ptr<FormImageHandles> m_handles;
     //! Default properties.
@@ -70,7 +72,12 @@ void FormImagePrivate::init()
 
 QRectF FormImagePrivate::imageRect() const
 {
-    return QRectF(q->pos(), QSizeF(m_image.size()));
+    return QRectF(q->pos(), QSizeF(image().size()));
+}
+
+const QImage &FormImagePrivate::image() const
+{
+    return m_image.image();
 }
 
 void FormImagePrivate::connectProperties()
@@ -180,19 +187,7 @@ Cfg::Image FormImage::cfg() const
 
     c.set_keepAspectRatio(d->m_handles->isKeepAspectRatio());
 
-    QByteArray byteArray;
-    QBuffer buffer(&byteArray);
-    d->m_image.save(&buffer, "PNG");
-
-    const auto sha256 = QCryptographicHash::hash(byteArray, QCryptographicHash::Sha256).toBase64();
-
-    Cfg::ImageData data;
-    data.set_sha256(sha256);
-    data.set_data(QString::fromLatin1(byteArray.toBase64().data()));
-
-    page()->imagesHash().insert(sha256, data);
-
-    c.set_sha256(sha256);
+    c.set_sha256(d->m_image.sha256());
 
     c.set_z(zValue());
 
@@ -207,20 +202,25 @@ void FormImage::setCfg(const Cfg::Image &c)
 
     d->m_handles->setKeepAspectRatio(c.keepAspectRatio());
 
-    QByteArray data;
+    ImageStore &store = page()->imageStore();
 
-    if (!c.sha256().isEmpty() && page()->imagesHash().contains(c.sha256())) {
-        data = QByteArray::fromBase64(page()->imagesHash().value(c.sha256()).data().toLatin1());
-    } else if (!c.data().isEmpty()) {
-        data = QByteArray::fromBase64(c.data().toLatin1());
-    } else {
-        QBuffer buffer(&data);
-        QImage(QStringLiteral(":/Core/img/broken.png")).save(&buffer, "PNG");
+    ImageHandle image;
+
+    if (!c.sha256().isEmpty()) {
+        image = store.image(c.sha256());
+    }
+
+    if (image.isNull() && !c.data().isEmpty()) {
+        image = store.insert(QByteArray::fromBase64(c.data().toLatin1()), "PNG");
     }
 
-    d->m_image = QImage::fromData(data, "PNG");
+    if (image.isNull() || image.image().isNull()) {
+        image = store.insert(QImage(QStringLiteral(":/Core/img/broken.png")));
+    }
 
-    setPixmap(QPixmap::fromImage(d->m_image.scaled(s,
+    d->m_image = image.pinned();
+
+    setPixmap(QPixmap::fromImage(d->image().scaled(s,
                                                    (c.keepAspectRatio() ? Qt::KeepAspectRatio : Qt::IgnoreAspectRatio),
                                                    Qt::SmoothTransformation)));
 
@@ -237,22 +237,59 @@ void FormImage::setCfg(const Cfg::Image &c)
 
 const QImage &FormImage::image() const
 {
-    return d->m_image;
+    return d->image();
 }
 
 void FormImage::setImage(const QImage &img)
 {
-    d->m_image = img;
+    setImage(page()->imageStore().insert(img));
+}
 
-    setPixmap(QPixmap::fromImage(d->m_image));
+bool FormImage::setEncodedImage(const QByteArray &data,
+                                const QByteArray &format)
+{
+    const ImageHandle image = page()->imageStore().insert(data, format.toUpper());
 
-    QRectF r = d->m_image.rect();
+    if (image.image().isNull()) {
+        return false;
+    }
+
+    setImage(image);
+
+    return true;
+}
+
+void FormImage::setImage(const ImageHandle &image)
+{
+    d->m_image = image.pinned();
+
+    setPixmap(QPixmap::fromImage(d->image()));
+
+    QRectF r = d->image().rect();
     r.moveTop(pos().y());
     r.moveLeft(pos().x());
 
     d->m_handles->setRect(r);
 }
 
+QList<QByteArray> FormImage::preservedFormats()
+{
+    static const QList<QByteArray> formats = []() {
+        QList<QByteArray> res;
+        const auto supported = QImageReader::supportedImageFormats();
+
+        for (const auto &f : {QByteArray("jpeg"), QByteArray("png"), QByteArray("webp")}) {
+            if (supported.contains(f)) {
+                res.append(f);
+            }
+        }
+
+        return res;
+    }();
+
+    return formats;
+}
+
 void FormImage::paint(QPainter *painter,
                       const QStyleOptionGraphicsItem *option,
                       QWidget *widget)
@@ -309,7 +346,7 @@ void FormImage::resize(const QRectF &rect)
     setPos(rect.topLeft());
 
     setPixmap(QPixmap::fromImage(
-        d->m_image.scaled(QSize(qRound(rect.width()), qRound(rect.height())),
+        d->image().scaled(QSize(qRound(rect.width()), qRound(rect.height())),
                           (d->m_handles->isKeepAspectRatio() ? Qt::KeepAspectRatio : Qt::IgnoreAspectRatio),
                           Qt::SmoothTransformation)));
 
@@ -24,6 +24,7 @@ namespace Prototyper
 namespace Core
 {
 
+class ImageHandle;
 class Page;
 
 //
@@ -46,6 +47,14 @@ public:
         return ImageType;
     }
 
+    //! Type of the graphics item.
+    enum { Type = FormObjectItemType + ImageType };
+
+    int type() const override
+    {
+        return Type;
+    }
+
     //! \return Cfg.
     Cfg::Image cfg() const;
     //! Set cfg.
@@ -55,6 +64,13 @@ public:
     const QImage &image() const;
     //! Set image.
     void setImage(const QImage &img);
+    //! Set image from encoded data, the data is stored in the project as is.
+    //! \return false if the data can't be decoded.
+    bool setEncodedImage(const QByteArray &data,
+                         const QByteArray &format);
+
+    //! \return Formats that are stored in the project without re-encoding.
+    static QList<QByteArray> preservedFormats();
 
     void paint(QPainter *painter,
                const QStyleOptionGraphicsItem *option,
@@ -87,6 +103,10 @@ protected:
     //! Move resizable.
     void moveResizable(const QPointF &delta) override;
 
+private:
+    //! Set image from the store.
+    void setImage(const ImageHandle &image);
+
 private:
     Q_DISABLE_COPY(FormImage)
 
@@ -0,0 +1,330 @@
+
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// Prototyper include.
+#include "image_store.hpp"
+#include "../project_bundle.hpp"
+#include "../project_file.hpp"
+
+// Qt include.
+#include <QBuffer>
+#include <QCryptographicHash>
+
+// C++ include.
+#include <algorithm>
+
+namespace Prototyper
+{
+
+namespace Core
+{
+
+//
+// ImageStoreEntry
+//
+
+//! Image in the store.
+class ImageStoreEntry final
+{
+public:
+    explicit ImageStoreEntry(const Cfg::ImageData &data)
+        : m_data(data)
+        , m_refs(0)
+        , m_pins(0)
+    {
+    }
+
+    //! \return Encoded image, read from the file on first access.
+    const Cfg::ImageData &data()
+    {
+        if (!m_fileName.isEmpty()) {
+            try {
+                m_data = readBundleImage(m_data.sha256(), m_fileName);
+            } catch (const ProjectFileException &) {
+                // Missing image is drawn empty.
+            }
+
+            m_fileName.clear();
+        }
+
+        return m_data;
+    }
+
+    //! \return Decoded image.
+    const QImage &image()
+    {
+        if (m_image.isNull()) {
+            m_image = ImageStore::decode(data());
+        }
+
+        return m_image;
+    }
+
+    //! Add reference.
+    //! \param pin Keep decoded image too.
+    void ref(bool pin)
+    {
+        ++m_refs;
+
+        if (pin) {
+            ++m_pins;
+        }
+    }
+
+    //! Remove reference. Decoded image is dropped with the last pin.
+    void deref(bool pin)
+    {
+        --m_refs;
+
+        if (pin && --m_pins == 0) {
+            m_image = QImage();
+        }
+    }
+
+    //! Encoded image, only SHA-256 and format till the file is read.
+    Cfg::ImageData m_data;
+    //! File to read the encoded image from.
+    QString m_fileName;
+    //! Decoded image.
+    QImage m_image;
+    //! References, the image is used by the project while there are any.
+    int m_refs;
+    //! References keeping the decoded image.
+    int m_pins;
+}; // class ImageStoreEntry
+
+//
+// ImageHandle
+//
+
+ImageHandle::ImageHandle()
+    : m_isPinned(false)
+{
+}
+
+ImageHandle::ImageHandle(const std::shared_ptr<ImageStoreEntry> &entry,
+                         bool pin)
+    : m_entry(entry)
+    , m_isPinned(pin)
+{
+    if (m_entry) {
+        m_entry->ref(m_isPinned);
+    }
+}
+
+ImageHandle::ImageHandle(const ImageHandle &other)
+    : ImageHandle(other.m_entry, other.m_isPinned)
+{
+}
+
+ImageHandle &ImageHandle::operator=(const ImageHandle &other)
+{
+    if (m_entry != other.m_entry || m_isPinned != other.m_isPinned) {
+        if (other.m_entry) {
+            other.m_entry->ref(other.m_isPinned);
+        }
+
+        if (m_entry) {
+            m_entry->deref(m_isPinned);
+        }
+
+        m_entry = other.m_entry;
+        m_isPinned = other.m_isPinned;
+    }
+
+    return *this;
+}
+
+ImageHandle::~ImageHandle()
+{
+    if (m_entry) {
+        m_entry->deref(m_isPinned);
+    }
+}
+
+ImageHandle ImageHandle::pinned() const
+{
+    return ImageHandle(m_entry, true);
+}
+
+bool ImageHandle::isNull() const
+{
+    return !m_entry;
+}
+
+QString ImageHandle::sha256() const
+{
+    return (m_entry ? m_entry->m_data.sha256() : QString());
+}
+
+QString ImageHandle::format() const
+{
+    return (m_entry ? m_entry->m_data.format() : QString());
+}
+
+const Cfg::ImageData &ImageHandle::data() const
+{
+    static const Cfg::ImageData empty;
+
+    return (m_entry ? m_entry->data() : empty);
+}
+
+const QImage &ImageHandle::image() const
+{
+    static const QImage empty;
+
+    return (m_entry ? m_entry->image() : empty);
+}
+
+//
+// ImageStore
+//
+
+void ImageStore::clear()
+{
+    m_images.clear();
+}
+
+void ImageStore::setImages(const std::vector<Cfg::ImageData> &images,
+                           const QHash<QString, QImage> &decoded)
+{
+    m_images.clear();
+
+    for (const auto &data : images) {
+        if (!m_images.contains(data.sha256())) {
+            auto entry = std::make_shared<ImageStoreEntry>(data);
+            entry->m_image = decoded.value(data.sha256());
+
+            m_images.insert(data.sha256(), entry);
+        }
+    }
+}
+
+void ImageStore::addFile(const QString &sha256,
+                         const QString &format,
+                         const QString &fileName)
+{
+    if (!m_images.contains(sha256)) {
+        Cfg::ImageData data;
+        data.set_sha256(sha256);
+        data.set_format(format);
+
+        auto entry = std::make_shared<ImageStoreEntry>(data);
+        entry->m_fileName = fileName;
+
+        m_images.insert(sha256, entry);
+    }
+}
+
+ImageHandle ImageStore::image(const QString &sha256) const
+{
+    const auto it = m_images.constFind(sha256);
+
+    if (it != m_images.cend()) {
+        return ImageHandle(it.value(), false);
+    }
+
+    return ImageHandle();
+}
+
+ImageHandle ImageStore::insert(const QByteArray &data,
+                               const QByteArray &format)
+{
+    Cfg::ImageData c;
+    c.set_sha256(QString::fromLatin1(QCryptographicHash::hash(data, QCryptographicHash::Sha256).toBase64()));
+    c.set_data(QString::fromLatin1(data.toBase64()));
+    c.set_format(QString::fromLatin1(format));
+
+    return insert(c, QImage());
+}
+
+ImageHandle ImageStore::insert(const QImage &image)
+{
+    QByteArray data;
+    QBuffer buffer(&data);
+    image.save(&buffer, "PNG");
+
+    Cfg::ImageData c;
+    c.set_sha256(QString::fromLatin1(QCryptographicHash::hash(data, QCryptographicHash::Sha256).toBase64()));
+    c.set_data(QString::fromLatin1(data.toBase64()));
+    c.set_format(QStringLiteral("PNG"));
+
+    return insert(c, image);
+}
+
+ImageHandle ImageStore::insert(const Cfg::ImageData &data,
+                               const QImage &decoded)
+{
+    auto it = m_images.find(data.sha256());
+
+    if (it == m_images.end()) {
+        it = m_images.insert(data.sha256(), std::make_shared<ImageStoreEntry>(data));
+    }
+
+    if (it.value()->m_image.isNull() && !decoded.isNull()) {
+        it.value()->m_image = decoded;
+    }
+
+    return ImageHandle(it.value(), false);
+}
+
+int ImageStore::refCount(const QString &sha256) const
+{
+    const auto it = m_images.constFind(sha256);
+
+    return (it != m_images.cend() ? it.value()->m_refs : 0);
+}
+
+void ImageStore::releaseUnpinned()
+{
+    for (auto it = m_images.begin(), last = m_images.end(); it != last; ++it) {
+        if (it.value()->m_pins == 0) {
+            it.value()->m_image = QImage();
+        }
+    }
+}
+
+std::vector<Cfg::ImageData> ImageStore::usedImages() const
+{
+    std::vector<Cfg::ImageData> res;
+
+    for (auto it = m_images.cbegin(), last = m_images.cend(); it != last; ++it) {
+        if (it.value()->m_refs > 0) {
+            res.push_back(it.value()->data());
+        }
+    }
+
+    // Same project gives the same file.
+    std::sort(res.begin(), res.end(), [](const Cfg::ImageData &a, const Cfg::ImageData &b) {
+        return a.sha256() < b.sha256();
+    });
+
+    return res;
+}
+
+QStringList ImageStore::usedImageIds() const
+{
+    QStringList res;
+
+    for (auto it = m_images.cbegin(), last = m_images.cend(); it != last; ++it) {
+        if (it.value()->m_refs > 0) {
+            res.append(it.key());
+        }
+    }
+
+    res.sort();
+
+    return res;
+}
+
+QImage ImageStore::decode(const Cfg::ImageData &data)
+{
+    return QImage::fromData(QByteArray::fromBase64(data.data().toLatin1()), data.format().toLatin1().constData());
+}
+
+} /* namespace Core */
+
+} /* namespace Prototyper */
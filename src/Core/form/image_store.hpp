@@ -0,0 +1,139 @@
+
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#ifndef PROTOTYPER__CORE__IMAGE_STORE_HPP__INCLUDED
+#define PROTOTYPER__CORE__IMAGE_STORE_HPP__INCLUDED
+
+// Qt include.
+#include <QHash>
+#include <QImage>
+#include <QString>
+#include <QStringList>
+
+// C++ include.
+#include <memory>
+#include <vector>
+
+// Prototyper include.
+#include "project_cfg.hpp"
+
+namespace Prototyper
+{
+
+namespace Core
+{
+
+class ImageStoreEntry;
+
+//
+// ImageHandle
+//
+
+//! Shared handle to the image in the store. Every handle is one reference,
+//! only pinned handles keep the image decoded.
+class ImageHandle final
+{
+public:
+    ImageHandle();
+    ImageHandle(const ImageHandle &other);
+    ImageHandle &operator=(const ImageHandle &other);
+    ~ImageHandle();
+
+    //! \return Is handle empty?
+    bool isNull() const;
+
+    //! \return SHA-256 of the encoded image.
+    QString sha256() const;
+    //! \return Format of the encoded image.
+    QString format() const;
+    //! \return Encoded image, read from the file on first access.
+    const Cfg::ImageData &data() const;
+    //! \return Decoded image, decoded on first access.
+    const QImage &image() const;
+
+    //! \return Handle to the same image that keeps the decoded image in memory.
+    ImageHandle pinned() const;
+
+private:
+    friend class ImageStore;
+
+    ImageHandle(const std::shared_ptr<ImageStoreEntry> &entry,
+                bool pin);
+
+    //! Entry.
+    std::shared_ptr<ImageStoreEntry> m_entry;
+    //! Does the handle keep the decoded image?
+    bool m_isPinned;
+}; // class ImageHandle
+
+//
+// ImageStore
+//
+
+//! Project-wide store of images keyed by SHA-256 of the encoded data.
+//! Each image is kept once however many times it's placed. Entries stay
+//! in the store without references too, so undo can bring them back,
+//! but only referenced images are saved. Decoded image is kept while
+//! items on materialized pages hold pinned handles to it.
+class ImageStore final
+{
+public:
+    ImageStore() = default;
+    ~ImageStore() = default;
+
+    //! Remove all images.
+    void clear();
+    //! Set images of the opened project.
+    //! \param decoded Images decoded in advance, keyed by SHA-256.
+    void setImages(const std::vector<Cfg::ImageData> &images,
+                   const QHash<QString, QImage> &decoded = QHash<QString, QImage>());
+
+    //! Add image of the project bundle, the file is read on first access.
+    void addFile(const QString &sha256,
+                 const QString &format,
+                 const QString &fileName);
+
+    //! \return Handle to the image with the given SHA-256, null if there is no such image.
+    ImageHandle image(const QString &sha256) const;
+
+    //! Add encoded image.
+    //! \return Handle to the added or already present image.
+    ImageHandle insert(const QByteArray &data,
+                       const QByteArray &format);
+    //! Add image, it will be encoded to PNG.
+    //! \return Handle to the added or already present image.
+    ImageHandle insert(const QImage &image);
+
+    //! \return Count of references to the image.
+    int refCount(const QString &sha256) const;
+    //! Drop decoded images no pinned handle refers to, they're decoded again on access.
+    void releaseUnpinned();
+
+    //! \return Referenced images, each one once.
+    std::vector<Cfg::ImageData> usedImages() const;
+    //! \return SHA-256 of referenced images, sorted, files of images are not read.
+    QStringList usedImageIds() const;
+
+    //! \return Decoded image. Thread-safe.
+    static QImage decode(const Cfg::ImageData &data);
+
+private:
+    //! Add entry.
+    ImageHandle insert(const Cfg::ImageData &data,
+                       const QImage &decoded);
+
+private:
+    Q_DISABLE_COPY(ImageStore)
+
+    //! Images.
+    QHash<QString, std::shared_ptr<ImageStoreEntry>> m_images;
+}; // class ImageStore
+
+} /* namespace Core */
+
+} /* namespace Prototyper */
+
+#endif // PROTOTYPER__CORE__IMAGE_STORE_HPP__INCLUDED
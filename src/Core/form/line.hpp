@@ -47,6 +47,14 @@ public:
         return LineType;
     }
 
+    //! Type of the graphics item.
+    enum { Type = FormObjectItemType + LineType };
+
+    int type() const override
+    {
+        return Type;
+    }
+
     //! \return Cfg.
     Cfg::Line cfg() const;
     //! Set cfg.
@@ -14,6 +14,9 @@
 // C++ include.
 #include <memory>
 
+// Prototyper include.
+#include "../types.hpp"
+
 namespace Prototyper
 {
 
@@ -66,6 +69,14 @@ public:
                    bool followCursor = false);
     ~FormMoveHandle() override;
 
+    //! Type of the graphics item.
+    enum { Type = MoveHandleItemType };
+
+    int type() const override
+    {
+        return Type;
+    }
+
     //! \return Half of the size of the edge.
     qreal halfOfSize() const;
 
@@ -13,6 +13,9 @@
 // C++ include.
 #include <memory>
 
+// Prototyper include.
+#include "../types.hpp"
+
 namespace Prototyper
 {
 
@@ -38,6 +41,14 @@ public:
     explicit NodesEditResizeHandle(QGraphicsItem *parent);
     ~NodesEditResizeHandle() override;
 
+    //! Type of the graphics item.
+    enum { Type = NodesEditResizeHandleItemType };
+
+    int type() const override
+    {
+        return Type;
+    }
+
     //! Mode.
     enum Mode {
         NodesEditMode = 0,
@@ -6,6 +6,7 @@
 
 // Prototyper include.
 #include "object.hpp"
+#include "page.hpp"
 #include "properties/object_properties.hpp"
 #include "properties/ui_object_properties.h"
 #include "undo_commands.hpp"
@@ -73,7 +74,12 @@ FormObject::FormObject(ObjectType t,
 {
 }
 
-FormObject::~FormObject() = default;
+FormObject::~FormObject()
+{
+    if (d->m_type != PageType && d->m_form) {
+        d->m_form->unregisterObject(d->m_id, this);
+    }
+}
 
 QWidget *FormObject::properties(QWidget *parent)
 {
@@ -144,6 +150,12 @@ const QString &FormObject::objectId() const
 
 void FormObject::setObjectId(const QString &i)
 {
+    // Page keeps index of its objects by IDs.
+    if (d->m_type != PageType && d->m_form) {
+        d->m_form->unregisterObject(d->m_id, this);
+        d->m_form->registerObject(i, this);
+    }
+
     d->m_id = i;
 }
 
@@ -231,6 +243,66 @@ void FormObject::setRectangle(const QRectF &rect,
     }
 }
 
+//
+// formObject
+//
+
+FormObject *formObject(QGraphicsItem *item)
+{
+    if (!item) {
+        return nullptr;
+    }
+
+    switch (item->type()) {
+    case FormLine::Type:
+        return qgraphicsitem_cast<FormLine *>(item);
+
+    case FormPolyline::Type:
+        return qgraphicsitem_cast<FormPolyline *>(item);
+
+    case FormText::Type:
+        return qgraphicsitem_cast<FormText *>(item);
+
+    case FormImage::Type:
+        return qgraphicsitem_cast<FormImage *>(item);
+
+    case FormRect::Type:
+        return qgraphicsitem_cast<FormRect *>(item);
+
+    // FormGroup::Type is QGraphicsItemGroup::Type, any group is cast to
+    // FormGroup. Pages never hold plain QGraphicsItemGroup items.
+    case FormGroup::Type:
+        return qgraphicsitem_cast<FormGroup *>(item);
+
+    case Page::Type:
+        return qgraphicsitem_cast<Page *>(item);
+
+    case FormButton::Type:
+        return qgraphicsitem_cast<FormButton *>(item);
+
+    case FormComboBox::Type:
+        return qgraphicsitem_cast<FormComboBox *>(item);
+
+    case FormRadioButton::Type:
+        return qgraphicsitem_cast<FormRadioButton *>(item);
+
+    case FormCheckBox::Type:
+        return qgraphicsitem_cast<FormCheckBox *>(item);
+
+    case FormHSlider::Type:
+        return qgraphicsitem_cast<FormHSlider *>(item);
+
+    case FormVSlider::Type:
+        return qgraphicsitem_cast<FormVSlider *>(item);
+
+    case FormSpinBox::Type:
+        return qgraphicsitem_cast<FormSpinBox *>(item);
+
+    default:
+        return nullptr;
+    }
+}
+
 } /* namespace Core */
 
 } /* namespace Prototyper */
@@ -15,6 +15,9 @@
 // C++ include.
 #include <memory>
 
+// Prototyper include.
+#include "../types.hpp"
+
 namespace Prototyper
 {
 
@@ -137,6 +140,10 @@ private:
     std::unique_ptr<FormObjectPrivate> d;
 }; // class FormObject
 
+//! \return Form object of the graphics item or nullptr. It's dispatched on
+//! QGraphicsItem::type(), there is no dynamic_cast.
+FormObject *formObject(QGraphicsItem *item);
+
 } /* namespace Core */
 
 } /* namespace Prototyper */
@@ -34,6 +34,7 @@
 #include <QMimeData>
 #include <QPainter>
 #include <QSharedPointer>
+#include <QStyleOptionGraphicsItem>
 #include <QTextCursor>
 #include <QUndoGroup>
 #include <QUndoStack>
@@ -41,6 +42,7 @@
 
 // C++ include.
 #include <algorithm>
+#include <cmath>
 #include <functional>
 #include <type_traits>
 
@@ -67,9 +69,55 @@ void PagePrivate::init()
 
     q->setAcceptDrops(true);
 
+    q->setFlag(QGraphicsItem::ItemUsesExtendedStyleOption, true);
+
     m_undoStack = new QUndoStack(TopGui::instance()->projectWindow()->projectWidget()->undoGroup());
 }
 
+void PagePrivate::draw(QPainter *painter,
+                       const QStyleOptionGraphicsItem *option) const
+{
+    const int width = m_cfg.size().width();
+    const int height = m_cfg.size().height();
+
+    // Page with the border, the pen is left for the grid.
+    Page::draw(painter, width, height, 0, false);
+
+    int step = MmPx::instance().fromMmX(m_cfg.gridStep());
+
+    if (m_gridMode != ShowGrid || step <= 0) {
+        return;
+    }
+
+    const QRectF exposed = option->exposedRect.intersected(QRectF(0.0, 0.0, width, height));
+
+    if (exposed.isEmpty()) {
+        return;
+    }
+
+    // Too dense grid is thinned by skipping every second line, the rest are on the grid still.
+    const qreal lod = QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+
+    while (step * lod < c_minGridSpacing && step < qMax(width, height)) {
+        step *= 2;
+    }
+
+    const int firstX = qMax(step, int(std::floor(exposed.left() / step)) * step);
+    const int firstY = qMax(step, int(std::floor(exposed.top() / step)) * step);
+
+    QVector<QLineF> lines;
+
+    for (int x = firstX; x <= exposed.right() && x < width; x += step) {
+        lines.append(QLineF(x, exposed.top(), x, exposed.bottom()));
+    }
+
+    for (int y = firstY; y <= exposed.bottom() && y < height; y += step) {
+        lines.append(QLineF(exposed.left(), y, exposed.right(), y));
+    }
+
+    painter->drawLines(lines);
+}
+
 bool PagePrivate::isCommentUnderMouse() const
 {
     for (const auto &c : std::as_const(m_comments)) {
@@ -107,7 +155,7 @@ void findZBorder(const QList<QGraphicsItem *> &items,
             findZBorder(children, z, false, u);
         }
 
-        auto *obj = dynamic_cast<FormObject *>(item);
+        auto *obj = formObject(item);
 
         if (obj && initZ) {
             z = item->zValue();
@@ -166,7 +214,7 @@ void PagePrivate::handleMouseMoveInCurrentPolyLine(const QPointF &point)
 void PagePrivate::ungroup(QGraphicsItem *group,
                           bool pushUndoCommand)
 {
-    auto *tmp = dynamic_cast<FormGroup *>(group);
+    auto *tmp = qgraphicsitem_cast<FormGroup *>(group);
 
     if (tmp) {
         m_current = Q_NULLPTR;
@@ -176,7 +224,7 @@ void PagePrivate::ungroup(QGraphicsItem *group,
         QStringList ids;
 
         foreach (QGraphicsItem *i, tmp->children()) {
-            ids.append(dynamic_cast<FormObject *>(i)->objectId());
+            ids.append(formObject(i)->objectId());
         }
 
         if (pushUndoCommand) {
@@ -186,7 +234,7 @@ void PagePrivate::ungroup(QGraphicsItem *group,
         foreach (QGraphicsItem *item, items) {
             tmp->removeFromGroup(item);
 
-            auto *o = dynamic_cast<FormObject *>(item);
+            auto *o = formObject(item);
 
             if (o) {
                 o->updateHandlesPos();
@@ -197,7 +245,7 @@ void PagePrivate::ungroup(QGraphicsItem *group,
 
                 item->setSelected(true);
 
-                auto *text = dynamic_cast<FormText *>(item);
+                auto *text = qgraphicsitem_cast<FormText *>(item);
 
                 if (text) {
                     text->enableEditing(false);
@@ -226,8 +274,6 @@ void PagePrivate::updateFromCfg()
 {
     clear();
 
-    QApplication::processEvents();
-
     Cfg::Size size;
     size.set_width(MmPx::instance().fromMmX(m_cfg.size().width()));
     size.set_height(MmPx::instance().fromMmY(m_cfg.size().height()));
@@ -238,7 +284,7 @@ void PagePrivate::updateFromCfg()
 
     q->setObjectId(m_cfg.tabName());
 
-    m_ids.append(m_cfg.tabName());
+    m_ids.insert(m_cfg.tabName());
 
     for (const Cfg::Line &c : m_cfg.line()) {
         createElem<FormLine>(c);
@@ -309,15 +355,13 @@ void PagePrivate::clear()
 
     QList<QGraphicsItem *> items = q->childItems();
 
-    QList<FormObject *> objs;
+    QList<QGraphicsItem *> objs;
 
     foreach (QGraphicsItem *item, items) {
-        auto *obj = dynamic_cast<FormObject *>(item);
-
-        if (obj) {
-            objs.append(obj);
+        if (formObject(item)) {
+            objs.append(item);
         } else {
-            auto *snap = dynamic_cast<GridSnap *>(item);
+            auto *snap = qgraphicsitem_cast<GridSnap *>(item);
 
             if (!snap) {
                 q->scene()->removeItem(item);
@@ -329,12 +373,8 @@ void PagePrivate::clear()
 
     std::reverse(objs.begin(), objs.end());
 
-    foreach (FormObject *obj, objs) {
-        auto *item = dynamic_cast<QGraphicsItem *>(obj);
-
-        if (item) {
-            q->scene()->removeItem(item);
-        }
+    foreach (QGraphicsItem *item, objs) {
+        q->scene()->removeItem(item);
     }
 
     foreach (QGraphicsItem *item, items) {
@@ -350,7 +390,7 @@ inline Elem *PagePrivate::createElem(const Config &cfg)
 
     e->setCfg(cfg);
 
-    m_ids.append(e->objectId());
+    m_ids.insert(e->objectId());
 
     return e;
 }
@@ -364,7 +404,7 @@ inline Elem *PagePrivate::createElemWithRect(const Config &cfg,
 
     e->setCfg(cfg);
 
-    m_ids.append(e->objectId());
+    m_ids.insert(e->objectId());
 
     return e;
 }
@@ -377,7 +417,7 @@ FormText *PagePrivate::createText(const Cfg::Text &cfg)
 
     text->setCfg(cfg);
 
-    m_ids.append(text->objectId());
+    m_ids.insert(text->objectId());
 
     m_docs.insert(text->document(), text);
 
@@ -399,15 +439,15 @@ FormGroup *PagePrivate::createGroup(const Cfg::Group &cfg)
 
 void PagePrivate::clearIds(FormGroup *group)
 {
-    m_ids.removeOne(group->objectId());
+    m_ids.remove(group->objectId());
 
     foreach (QGraphicsItem *item, group->childItems()) {
-        auto *obj = dynamic_cast<FormObject *>(item);
+        auto *obj = formObject(item);
 
         if (obj) {
-            m_ids.removeOne(obj->objectId());
+            m_ids.remove(obj->objectId());
 
-            auto *childGroup = dynamic_cast<FormGroup *>(item);
+            auto *childGroup = qgraphicsitem_cast<FormGroup *>(item);
 
             if (childGroup) {
                 clearIds(childGroup);
@@ -418,15 +458,15 @@ void PagePrivate::clearIds(FormGroup *group)
 
 void PagePrivate::addIds(FormGroup *group)
 {
-    m_ids.append(group->objectId());
+    m_ids.insert(group->objectId());
 
     foreach (QGraphicsItem *item, group->childItems()) {
-        auto *obj = dynamic_cast<FormObject *>(item);
+        auto *obj = formObject(item);
 
         if (obj) {
-            m_ids.append(obj->objectId());
+            m_ids.insert(obj->objectId());
 
-            auto *childGroup = dynamic_cast<FormGroup *>(item);
+            auto *childGroup = qgraphicsitem_cast<FormGroup *>(item);
 
             if (childGroup) {
                 addIds(childGroup);
@@ -446,12 +486,12 @@ void PagePrivate::setText(const QSharedPointer<QTextDocument> &doc,
 void PagePrivate::hideHandlesOfCurrent()
 {
     if (m_current) {
-        auto *obj = dynamic_cast<FormObject *>(m_current);
+        auto *obj = formObject(m_current);
 
         if (obj) {
             switch (obj->objectType()) {
             case FormObject::LineType: {
-                auto *line = dynamic_cast<FormLine *>(m_current);
+                auto *line = qgraphicsitem_cast<FormLine *>(m_current);
 
                 if (line) {
                     line->showHandles(false);
@@ -459,7 +499,7 @@ void PagePrivate::hideHandlesOfCurrent()
             } break;
 
             case FormObject::PolylineType: {
-                auto *line = dynamic_cast<FormPolyline *>(m_current);
+                auto *line = qgraphicsitem_cast<FormPolyline *>(m_current);
 
                 if (line) {
                     line->showHandles(false);
@@ -480,7 +520,7 @@ QList<QGraphicsItem *> PagePrivate::selection()
     QList<QGraphicsItem *> res;
 
     foreach (QGraphicsItem *i, items) {
-        if (dynamic_cast<FormObject *>(i)) {
+        if (formObject(i)) {
             res.append(i);
         }
     }
@@ -498,13 +538,13 @@ qreal PagePrivate::searchAlignPoint(const QList<QGraphicsItem *> &items,
         case AlignHorLeftPoint:
         case AlignHorCenterPoint:
         case AlignHorRightPoint: {
-            pos = dynamic_cast<FormObject *>(items.first())->position().x();
+            pos = formObject(items.first())->position().x();
         } break;
 
         case AlignVertTopPoint:
         case AlignVertCenterPoint:
         case AlignVertBottomPoint: {
-            pos = dynamic_cast<FormObject *>(items.first())->position().y();
+            pos = formObject(items.first())->position().y();
         } break;
 
         default:
@@ -518,40 +558,40 @@ qreal PagePrivate::searchAlignPoint(const QList<QGraphicsItem *> &items,
     foreach (QGraphicsItem *item, items) {
         switch (point) {
         case AlignHorLeftPoint: {
-            if (dynamic_cast<FormObject *>(item)->position().x() < pos) {
-                pos = dynamic_cast<FormObject *>(item)->position().x();
+            if (formObject(item)->position().x() < pos) {
+                pos = formObject(item)->position().x();
             }
         } break;
 
         case AlignHorCenterPoint: {
             ++count;
 
-            points.append(dynamic_cast<FormObject *>(item)->position().x()
+            points.append(formObject(item)->position().x()
                           + item->boundingRect().width() / c_halfDivider);
         } break;
 
         case AlignHorRightPoint: {
-            if (dynamic_cast<FormObject *>(item)->position().x() + item->boundingRect().width() > pos) {
-                pos = dynamic_cast<FormObject *>(item)->position().x() + item->boundingRect().width();
+            if (formObject(item)->position().x() + item->boundingRect().width() > pos) {
+                pos = formObject(item)->position().x() + item->boundingRect().width();
             }
         } break;
 
         case AlignVertTopPoint: {
-            if (dynamic_cast<FormObject *>(item)->position().y() > pos) {
-                pos = dynamic_cast<FormObject *>(item)->position().y();
+            if (formObject(item)->position().y() > pos) {
+                pos = formObject(item)->position().y();
             }
         } break;
 
         case AlignVertCenterPoint: {
             ++count;
 
-            points.append(dynamic_cast<FormObject *>(item)->position().y()
+            points.append(formObject(item)->position().y()
                           + item->boundingRect().height() / c_halfDivider);
         } break;
 
         case AlignVertBottomPoint: {
-            if (dynamic_cast<FormObject *>(item)->position().y() + item->boundingRect().height() > pos) {
-                pos = dynamic_cast<FormObject *>(item)->position().y() + item->boundingRect().height();
+            if (formObject(item)->position().y() + item->boundingRect().height() > pos) {
+                pos = formObject(item)->position().y() + item->boundingRect().height();
             }
         } break;
 
@@ -578,30 +618,32 @@ qreal PagePrivate::searchAlignPoint(const QList<QGraphicsItem *> &items,
 //
 
 Page::Page(Cfg::Page &c,
-           const ImagesHash &imagesHash,
+           ImageStore &imageStore,
            QGraphicsItem *parent)
     : QGraphicsObject(parent)
     , FormObject(FormObject::PageType,
                  this)
     , d(nullptr)
 {
-    auto tmp = std::make_unique<PagePrivate>(c, imagesHash, this);
+    auto tmp = std::make_unique<PagePrivate>(c, imageStore, this);
 
     tmp->init();
 
     d.swap(tmp);
 }
 
-Page::~Page() = default;
-
-ImagesHash &Page::imagesHash()
+Page::~Page()
 {
-    return d->m_imagesHash;
+    // Children unregister themselves, so they go while the index is alive.
+    // Deleting a child may delete its siblings, e.g. handles.
+    while (!childItems().isEmpty()) {
+        delete childItems().constFirst();
+    }
 }
 
-const ImagesHash &Page::imagesHash() const
+ImageStore &Page::imageStore() const
 {
-    return d->m_imagesHash;
+    return d->m_imageStore;
 }
 
 QUndoStack *Page::undoStack() const
@@ -616,6 +658,8 @@ const Cfg::Size &Page::size() const
 
 void Page::setSize(const Cfg::Size &s)
 {
+    prepareGeometryChange();
+
     d->m_cfg.set_size(s);
 
     update();
@@ -651,8 +695,6 @@ Cfg::Page Page::cfg() const
 {
     Cfg::Page c = d->m_cfg;
 
-    d->m_imagesHash.clear();
-
     Cfg::Size size;
     size.set_width(MmPx::instance().toMmX(d->m_cfg.size().width()));
     size.set_height(MmPx::instance().toMmY(d->m_cfg.size().height()));
@@ -678,12 +720,12 @@ Cfg::Page Page::cfg() const
     }
 
     foreach (QGraphicsItem *item, childItems()) {
-        auto *obj = dynamic_cast<FormObject *>(item);
+        auto *obj = formObject(item);
 
         if (obj) {
             switch (obj->objectType()) {
             case FormObject::LineType: {
-                auto *line = dynamic_cast<FormLine *>(item);
+                auto *line = qgraphicsitem_cast<FormLine *>(item);
 
                 if (line) {
                     c.line().push_back(line->cfg());
@@ -691,7 +733,7 @@ Cfg::Page Page::cfg() const
             } break;
 
             case FormObject::PolylineType: {
-                auto *poly = dynamic_cast<FormPolyline *>(item);
+                auto *poly = qgraphicsitem_cast<FormPolyline *>(item);
 
                 if (poly) {
                     c.polyline().push_back(poly->cfg());
@@ -699,7 +741,7 @@ Cfg::Page Page::cfg() const
             } break;
 
             case FormObject::TextType: {
-                auto *text = dynamic_cast<FormText *>(item);
+                auto *text = qgraphicsitem_cast<FormText *>(item);
 
                 if (text) {
                     c.text().push_back(text->cfg());
@@ -707,7 +749,7 @@ Cfg::Page Page::cfg() const
             } break;
 
             case FormObject::ImageType: {
-                auto *image = dynamic_cast<FormImage *>(item);
+                auto *image = qgraphicsitem_cast<FormImage *>(item);
 
                 if (image) {
                     c.image().push_back(image->cfg());
@@ -715,7 +757,7 @@ Cfg::Page Page::cfg() const
             } break;
 
             case FormObject::RectType: {
-                auto *rect = dynamic_cast<FormRect *>(item);
+                auto *rect = qgraphicsitem_cast<FormRect *>(item);
 
                 if (rect) {
                     c.rect().push_back(rect->cfg());
@@ -723,7 +765,7 @@ Cfg::Page Page::cfg() const
             } break;
 
             case FormObject::GroupType: {
-                auto *group = dynamic_cast<FormGroup *>(item);
+                auto *group = qgraphicsitem_cast<FormGroup *>(item);
 
                 if (group) {
                     c.group().push_back(group->cfg());
@@ -731,7 +773,7 @@ Cfg::Page Page::cfg() const
             } break;
 
             case FormObject::ButtonType: {
-                auto *btn = dynamic_cast<FormButton *>(item);
+                auto *btn = qgraphicsitem_cast<FormButton *>(item);
 
                 if (btn) {
                     c.button().push_back(btn->cfg());
@@ -739,7 +781,7 @@ Cfg::Page Page::cfg() const
             } break;
 
             case FormObject::CheckBoxType: {
-                auto *chk = dynamic_cast<FormCheckBox *>(item);
+                auto *chk = qgraphicsitem_cast<FormCheckBox *>(item);
 
                 if (chk) {
                     c.checkbox().push_back(chk->cfg());
@@ -747,7 +789,7 @@ Cfg::Page Page::cfg() const
             } break;
 
             case FormObject::RadioButtonType: {
-                auto *r = dynamic_cast<FormRadioButton *>(item);
+                auto *r = qgraphicsitem_cast<FormRadioButton *>(item);
 
                 if (r) {
                     c.radiobutton().push_back(r->cfg());
@@ -755,7 +797,7 @@ Cfg::Page Page::cfg() const
             } break;
 
             case FormObject::ComboBoxType: {
-                auto *cb = dynamic_cast<FormComboBox *>(item);
+                auto *cb = qgraphicsitem_cast<FormComboBox *>(item);
 
                 if (cb) {
                     c.combobox().push_back(cb->cfg());
@@ -763,7 +805,7 @@ Cfg::Page Page::cfg() const
             } break;
 
             case FormObject::SpinBoxType: {
-                auto *sb = dynamic_cast<FormSpinBox *>(item);
+                auto *sb = qgraphicsitem_cast<FormSpinBox *>(item);
 
                 if (sb) {
                     c.spinbox().push_back(sb->cfg());
@@ -771,7 +813,7 @@ Cfg::Page Page::cfg() const
             } break;
 
             case FormObject::HSliderType: {
-                auto *hs = dynamic_cast<FormHSlider *>(item);
+                auto *hs = qgraphicsitem_cast<FormHSlider *>(item);
 
                 if (hs) {
                     c.hslider().push_back(hs->cfg());
@@ -779,7 +821,7 @@ Cfg::Page Page::cfg() const
             } break;
 
             case FormObject::VSliderType: {
-                auto *vs = dynamic_cast<FormVSlider *>(item);
+                auto *vs = qgraphicsitem_cast<FormVSlider *>(item);
 
                 if (vs) {
                     c.vslider().push_back(vs->cfg());
@@ -799,6 +841,8 @@ Cfg::Page Page::cfg() const
 
 void Page::setCfg(const Cfg::Page &c)
 {
+    prepareGeometryChange();
+
     d->m_cfg = c;
 
     d->updateFromCfg();
@@ -845,9 +889,9 @@ GridSnap *Page::snapItem() const
     return d->m_snap;
 }
 
-const QStringList &Page::ids() const
+QStringList Page::ids() const
 {
-    return d->m_ids;
+    return d->m_ids.values();
 }
 
 QGraphicsItem *Page::findItem(const QString &id)
@@ -856,17 +900,19 @@ QGraphicsItem *Page::findItem(const QString &id)
         return this;
     }
 
-    QList<QGraphicsItem *> items = childItems();
-
-    foreach (QGraphicsItem *item, items) {
-        auto *obj = dynamic_cast<FormObject *>(item);
+    return dynamic_cast<QGraphicsItem *>(d->m_objects.value(id, Q_NULLPTR));
+}
 
-        if (obj && obj->objectId() == id) {
-            return item;
-        }
-    }
+void Page::registerObject(const QString &id,
+                          FormObject *obj)
+{
+    d->m_objects.insert(id, obj);
+}
 
-    return Q_NULLPTR;
+void Page::unregisterObject(const QString &id,
+                            FormObject *obj)
+{
+    d->m_objects.remove(id, obj);
 }
 
 void Page::group()
@@ -908,7 +954,7 @@ FormGroup *Page::group(const QList<QGraphicsItem *> &items,
 
         group->setObjectId(i);
 
-        d->m_ids.append(i);
+        d->m_ids.insert(i);
 
         foreach (QGraphicsItem *item, items) {
             item->setFlag(QGraphicsItem::ItemIsSelectable, false);
@@ -961,7 +1007,7 @@ void Page::alignVerticalTop()
         const qreal y = d->searchAlignPoint(items, PagePrivate::AlignVertTopPoint);
 
         foreach (QGraphicsItem *item, items) {
-            dynamic_cast<FormObject *>(item)->setPosition(QPointF(dynamic_cast<FormObject *>(item)->position().x(), y));
+            formObject(item)->setPosition(QPointF(formObject(item)->position().x(), y));
         }
 
         emit changed();
@@ -976,12 +1022,12 @@ void Page::alignVerticalCenter()
         const qreal y = d->searchAlignPoint(items, PagePrivate::AlignVertCenterPoint);
 
         foreach (QGraphicsItem *item, items) {
-            const qreal iy = dynamic_cast<FormObject *>(item)->position().y();
+            const qreal iy = formObject(item)->position().y();
 
             const qreal cy = iy + item->boundingRect().height() / 2.0;
 
-            dynamic_cast<FormObject *>(item)->setPosition(
-                QPointF(dynamic_cast<FormObject *>(item)->position().x(), iy + y - cy));
+            formObject(item)->setPosition(
+                QPointF(formObject(item)->position().x(), iy + y - cy));
         }
 
         emit changed();
@@ -996,8 +1042,8 @@ void Page::alignVerticalBottom()
         const qreal y = d->searchAlignPoint(items, PagePrivate::AlignVertBottomPoint);
 
         foreach (QGraphicsItem *item, items) {
-            dynamic_cast<FormObject *>(item)->setPosition(
-                QPointF(dynamic_cast<FormObject *>(item)->position().x(), y - item->boundingRect().height()));
+            formObject(item)->setPosition(
+                QPointF(formObject(item)->position().x(), y - item->boundingRect().height()));
         }
 
         emit changed();
@@ -1012,7 +1058,7 @@ void Page::alignHorizontalLeft()
         const qreal x = d->searchAlignPoint(items, PagePrivate::AlignHorLeftPoint);
 
         foreach (QGraphicsItem *item, items) {
-            dynamic_cast<FormObject *>(item)->setPosition(QPointF(x, dynamic_cast<FormObject *>(item)->position().y()));
+            formObject(item)->setPosition(QPointF(x, formObject(item)->position().y()));
         }
 
         emit changed();
@@ -1027,12 +1073,12 @@ void Page::alignHorizontalCenter()
         const qreal x = d->searchAlignPoint(items, PagePrivate::AlignHorCenterPoint);
 
         foreach (QGraphicsItem *item, items) {
-            const qreal ix = dynamic_cast<FormObject *>(item)->position().x();
+            const qreal ix = formObject(item)->position().x();
 
             const qreal cx = ix + item->boundingRect().width() / 2.0;
 
-            dynamic_cast<FormObject *>(item)->setPosition(
-                QPointF(ix + x - cx, dynamic_cast<FormObject *>(item)->position().y()));
+            formObject(item)->setPosition(
+                QPointF(ix + x - cx, formObject(item)->position().y()));
         }
 
         emit changed();
@@ -1047,11 +1093,11 @@ void Page::alignHorizontalRight()
         const qreal x = d->searchAlignPoint(items, PagePrivate::AlignHorRightPoint);
 
         foreach (QGraphicsItem *item, items) {
-            dynamic_cast<FormObject *>(item)->setPosition(
-                QPointF(dynamic_cast<FormObject *>(item)->position().x()
+            formObject(item)->setPosition(
+                QPointF(formObject(item)->position().x()
                             + x
-                            - (dynamic_cast<FormObject *>(item)->position().x() + item->boundingRect().width()),
-                        dynamic_cast<FormObject *>(item)->position().y()));
+                            - (formObject(item)->position().x() + item->boundingRect().width()),
+                        formObject(item)->position().y()));
         }
 
         emit changed();
@@ -1062,93 +1108,94 @@ static inline void pushUndoDeleteCommand(QUndoStack *stack,
                                          FormObject *obj,
                                          Page *form)
 {
+    // Types of objects are unique, static casts are safe.
     switch (obj->objectType()) {
     case FormObject::LineType: {
-        auto *item = dynamic_cast<FormLine *>(obj);
+        auto *item = static_cast<FormLine *>(obj);
         Cfg::Line cfg = item->cfg();
 
         stack->push(new UndoDelete<std::remove_pointer_t<decltype(item)>, decltype(cfg)>(form, cfg));
     } break;
 
     case FormObject::PolylineType: {
-        auto *item = dynamic_cast<FormPolyline *>(obj);
+        auto *item = static_cast<FormPolyline *>(obj);
         Cfg::Polyline cfg = item->cfg();
 
         stack->push(new UndoDelete<std::remove_pointer_t<decltype(item)>, decltype(cfg)>(form, cfg));
     } break;
 
     case FormObject::TextType: {
-        auto *item = dynamic_cast<FormText *>(obj);
+        auto *item = static_cast<FormText *>(obj);
         Cfg::Text cfg = item->cfg();
 
         stack->push(new UndoDelete<std::remove_pointer_t<decltype(item)>, decltype(cfg)>(form, cfg));
     } break;
 
     case FormObject::ImageType: {
-        auto *item = dynamic_cast<FormImage *>(obj);
+        auto *item = static_cast<FormImage *>(obj);
         Cfg::Image cfg = item->cfg();
 
         stack->push(new UndoDelete<std::remove_pointer_t<decltype(item)>, decltype(cfg)>(form, cfg));
     } break;
 
     case FormObject::RectType: {
-        auto *item = dynamic_cast<FormRect *>(obj);
+        auto *item = static_cast<FormRect *>(obj);
         Cfg::Rect cfg = item->cfg();
 
         stack->push(new UndoDelete<std::remove_pointer_t<decltype(item)>, decltype(cfg)>(form, cfg));
     } break;
 
     case FormObject::GroupType: {
-        auto *item = dynamic_cast<FormGroup *>(obj);
+        auto *item = static_cast<FormGroup *>(obj);
         Cfg::Group cfg = item->cfg();
 
         stack->push(new UndoDelete<std::remove_pointer_t<decltype(item)>, decltype(cfg)>(form, cfg));
     } break;
 
     case FormObject::ButtonType: {
-        auto *item = dynamic_cast<FormButton *>(obj);
+        auto *item = static_cast<FormButton *>(obj);
         Cfg::Button cfg = item->cfg();
 
         stack->push(new UndoDelete<std::remove_pointer_t<decltype(item)>, decltype(cfg)>(form, cfg));
     } break;
 
     case FormObject::ComboBoxType: {
-        auto *item = dynamic_cast<FormComboBox *>(obj);
+        auto *item = static_cast<FormComboBox *>(obj);
         Cfg::ComboBox cfg = item->cfg();
 
         stack->push(new UndoDelete<std::remove_pointer_t<decltype(item)>, decltype(cfg)>(form, cfg));
     } break;
 
     case FormObject::RadioButtonType: {
-        auto *item = dynamic_cast<FormRadioButton *>(obj);
+        auto *item = static_cast<FormRadioButton *>(obj);
         Cfg::CheckBox cfg = item->cfg();
 
         stack->push(new UndoDelete<std::remove_pointer_t<decltype(item)>, decltype(cfg)>(form, cfg));
     } break;
 
     case FormObject::CheckBoxType: {
-        auto *item = dynamic_cast<FormCheckBox *>(obj);
+        auto *item = static_cast<FormCheckBox *>(obj);
         Cfg::CheckBox cfg = item->cfg();
 
         stack->push(new UndoDelete<std::remove_pointer_t<decltype(item)>, decltype(cfg)>(form, cfg));
     } break;
 
     case FormObject::HSliderType: {
-        auto *item = dynamic_cast<FormHSlider *>(obj);
+        auto *item = static_cast<FormHSlider *>(obj);
         Cfg::HSlider cfg = item->cfg();
 
         stack->push(new UndoDelete<std::remove_pointer_t<decltype(item)>, decltype(cfg)>(form, cfg));
     } break;
 
     case FormObject::VSliderType: {
-        auto *item = dynamic_cast<FormVSlider *>(obj);
+        auto *item = static_cast<FormVSlider *>(obj);
         Cfg::VSlider cfg = item->cfg();
 
         stack->push(new UndoDelete<std::remove_pointer_t<decltype(item)>, decltype(cfg)>(form, cfg));
     } break;
 
     case FormObject::SpinBoxType: {
-        auto *item = dynamic_cast<FormSpinBox *>(obj);
+        auto *item = static_cast<FormSpinBox *>(obj);
         Cfg::SpinBox cfg = item->cfg();
 
         stack->push(new UndoDelete<std::remove_pointer_t<decltype(item)>, decltype(cfg)>(form, cfg));
@@ -1175,18 +1222,18 @@ void Page::deleteItems(const QList<QGraphicsItem *> &items,
             d->m_currentPoly = nullptr;
         }
 
-        auto *obj = dynamic_cast<FormObject *>(item);
+        auto *obj = formObject(item);
 
         if (obj) {
             if (makeUndoCommand) {
                 pushUndoDeleteCommand(d->m_undoStack, obj, this);
             }
 
-            d->m_ids.removeOne(obj->objectId());
+            d->m_ids.remove(obj->objectId());
 
             switch (obj->objectType()) {
             case FormObject::GroupType: {
-                auto *group = dynamic_cast<FormGroup *>(item);
+                auto *group = qgraphicsitem_cast<FormGroup *>(item);
 
                 if (group) {
                     d->clearIds(group);
@@ -1196,7 +1243,7 @@ void Page::deleteItems(const QList<QGraphicsItem *> &items,
             } break;
 
             case FormObject::TextType: {
-                auto *text = dynamic_cast<FormText *>(item);
+                auto *text = qgraphicsitem_cast<FormText *>(item);
 
                 if (text) {
                     removeDocFromMap(text->document());
@@ -1230,14 +1277,9 @@ void Page::paint(QPainter *painter,
                  const QStyleOptionGraphicsItem *option,
                  QWidget *widget)
 {
-    Q_UNUSED(option)
     Q_UNUSED(widget)
 
-    draw(painter,
-         d->m_cfg.size().width(),
-         d->m_cfg.size().height(),
-         MmPx::instance().fromMmX(d->m_cfg.gridStep()),
-         d->m_gridMode == ShowGrid);
+    d->draw(painter, option);
 }
 
 void Page::draw(QPainter *painter,
@@ -1322,9 +1364,9 @@ void Page::renameForm(const QString &name)
 
     setObjectId(name);
 
-    d->m_ids.removeOne(old);
+    d->m_ids.remove(old);
 
-    d->m_ids.append(name);
+    d->m_ids.insert(name);
 
     d->m_cfg.set_tabName(name);
 }
@@ -1334,7 +1376,7 @@ void Page::clearEditModeInTexts()
     const auto items = childItems();
 
     for (const auto &i : items) {
-        auto *t = dynamic_cast<FormText *>(i);
+        auto *t = qgraphicsitem_cast<FormText *>(i);
 
         if (t) {
             t->clearEditMode();
@@ -1358,7 +1400,7 @@ void Page::undoCommandInTextAdded()
 
 void Page::contextMenuEvent(QGraphicsSceneContextMenuEvent *event)
 {
-    auto *placer = dynamic_cast<FormRectPlacer *>(d->m_current);
+    auto *placer = qgraphicsitem_cast<FormRectPlacer *>(d->m_current);
 
     delete placer;
 
@@ -1426,7 +1468,7 @@ void Page::mouseMoveEvent(QGraphicsSceneMouseEvent *mouseEvent)
 
         switch (PageAction::instance()->mode()) {
         case PageAction::DrawLine: {
-            auto *line = dynamic_cast<FormLine *>(d->m_current);
+            auto *line = qgraphicsitem_cast<FormLine *>(d->m_current);
 
             if (line) {
                 const QLineF l = line->line();
@@ -1453,7 +1495,7 @@ void Page::mouseMoveEvent(QGraphicsSceneMouseEvent *mouseEvent)
         case PageAction::DrawSpinBox:
         case PageAction::DrawHSlider:
         case PageAction::DrawVSlider: {
-            auto *rect = dynamic_cast<FormRectPlacer *>(d->m_current);
+            auto *rect = qgraphicsitem_cast<FormRectPlacer *>(d->m_current);
 
             if (rect) {
                 rect->setEndPos(mouseEvent->pos());
@@ -1467,7 +1509,7 @@ void Page::mouseMoveEvent(QGraphicsSceneMouseEvent *mouseEvent)
         } break;
 
         case PageAction::DrawRect: {
-            auto *rect = dynamic_cast<FormRect *>(d->m_current);
+            auto *rect = qgraphicsitem_cast<FormRect *>(d->m_current);
 
             if (rect) {
                 QRectF r = rect->rectangle();
@@ -1527,7 +1569,7 @@ void Page::mousePressEvent(QGraphicsSceneMouseEvent *mouseEvent)
 
             line->setObjectId(id);
 
-            d->m_ids.append(id);
+            d->m_ids.insert(id);
 
             d->m_current = line;
 
@@ -1588,7 +1630,7 @@ void Page::mousePressEvent(QGraphicsSceneMouseEvent *mouseEvent)
 
             rect->setObjectId(id);
 
-            d->m_ids.append(id);
+            d->m_ids.insert(id);
 
             QPointF p = mouseEvent->pos();
 
@@ -1620,7 +1662,7 @@ Elem *onReleaseWithRectPlacer(QGraphicsScene *scene,
 {
     scene->removeItem(d->m_current);
 
-    auto *rect = dynamic_cast<FormRectPlacer *>(d->m_current);
+    auto *rect = qgraphicsitem_cast<FormRectPlacer *>(d->m_current);
 
     Elem *elem = nullptr;
 
@@ -1667,7 +1709,7 @@ Elem *onReleaseWithRectPlacer(QGraphicsScene *scene,
 
         elem->setZValue(d->currentZValue() + 1.0);
 
-        d->m_ids.append(id);
+        d->m_ids.insert(id);
 
         d->m_undoStack->push(new UndoCreate<Elem, Config>(form, elem->objectId()));
     }
@@ -1692,7 +1734,7 @@ void Page::mouseReleaseEvent(QGraphicsSceneMouseEvent *mouseEvent)
 
         switch (PageAction::instance()->mode()) {
         case PageAction::DrawLine: {
-            auto *line = dynamic_cast<FormLine *>(d->m_current);
+            auto *line = qgraphicsitem_cast<FormLine *>(d->m_current);
 
             if (line) {
                 if (!d->m_polyline) {
@@ -1788,7 +1830,7 @@ void Page::mouseReleaseEvent(QGraphicsSceneMouseEvent *mouseEvent)
         } break;
 
         case PageAction::DrawRect: {
-            auto *rect = dynamic_cast<FormRect *>(d->m_current);
+            auto *rect = qgraphicsitem_cast<FormRect *>(d->m_current);
 
             if (rect) {
                 QPointF p = mouseEvent->pos();
@@ -1945,7 +1987,7 @@ void Page::dropEvent(QGraphicsSceneDragDropEvent *event)
 
         d->m_undoStack->push(new UndoCreate<FormImage, Cfg::Image>(this, image->objectId()));
 
-        d->m_ids.append(id);
+        d->m_ids.insert(id);
 
         if (PageAction::instance()->mode() == PageAction::Select) {
             image->setFlag(QGraphicsItem::ItemIsSelectable, true);
@@ -1961,7 +2003,22 @@ void Page::dropEvent(QGraphicsSceneDragDropEvent *event)
             image->setPos(event->pos());
         }
 
-        image->setImage(qvariant_cast<QImage>(event->mimeData()->imageData()));
+        bool isEncoded = false;
+
+        for (const auto &format : FormImage::preservedFormats()) {
+            const QString mimeType = QStringLiteral("image/") + QString::fromLatin1(format);
+
+            if (event->mimeData()->hasFormat(mimeType)
+                && image->setEncodedImage(event->mimeData()->data(mimeType), format)) {
+                isEncoded = true;
+
+                break;
+            }
+        }
+
+        if (!isEncoded) {
+            image->setImage(qvariant_cast<QImage>(event->mimeData()->imageData()));
+        }
 
         event->acceptProposedAction();
 
@@ -2005,7 +2062,7 @@ void Page::setCurrentPolyLine(FormPolyline *line)
 QString Page::nextId()
 {
     const auto id = d->id();
-    d->m_ids.append(id);
+    d->m_ids.insert(id);
 
     return id;
 }
@@ -2035,6 +2092,11 @@ void Page::clearCommentChanged()
     d->m_isCommentChanged = false;
 }
 
+void Page::setCommentChanged()
+{
+    d->m_isCommentChanged = true;
+}
+
 qreal Page::topZ() const
 {
     return d->currentZValue();
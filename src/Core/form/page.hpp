@@ -74,7 +74,7 @@ signals:
 
 public:
     Page(Cfg::Page &c,
-         const ImagesHash &imagesHash,
+         ImageStore &imageStore,
          QGraphicsItem *parent = 0);
     ~Page() override;
 
@@ -84,10 +84,16 @@ public:
         return PageType;
     }
 
-    //! \return Hash of images.
-    ImagesHash &imagesHash();
-    //! \return Hash of images.
-    const ImagesHash &imagesHash() const;
+    //! Type of the graphics item.
+    enum { Type = FormObjectItemType + PageType };
+
+    int type() const override
+    {
+        return Type;
+    }
+
+    //! \return Project's store of images.
+    ImageStore &imageStore() const;
 
     //! \return Undo stack.
     QUndoStack *undoStack() const;
@@ -124,9 +130,9 @@ public:
     GridSnap *snapItem() const;
 
     //! \return IDs.
-    const QStringList &ids() const;
+    QStringList ids() const;
 
-    //! \return Item with the given id.
+    //! \return Item with the given id, items of groups included.
     QGraphicsItem *findItem(const QString &id);
 
     //! Group selection.
@@ -196,6 +202,8 @@ public:
     bool isCommentChanged() const;
     //! Clear comment changed flag.
     void clearCommentChanged();
+    //! Set comment changed flag.
+    void setCommentChanged();
 
     //! \return Max Z index on the page.
     qreal topZ() const;
@@ -313,13 +321,21 @@ protected:
 
         dynamic_cast<QGraphicsItem *>(obj)->setZValue(d->currentZValue() + 1.0);
 
-        d->m_ids.append(id);
+        d->m_ids.insert(id);
 
         return obj;
     }
 
 private:
     friend class PagePrivate;
+    friend class FormObject;
+
+    //! Register object with the given ID.
+    void registerObject(const QString &id,
+                        FormObject *obj);
+    //! Unregister object with the given ID.
+    void unregisterObject(const QString &id,
+                          FormObject *obj);
 
     Q_DISABLE_COPY(Page)
 
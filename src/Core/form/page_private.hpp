@@ -10,7 +10,10 @@
 // Qt include.
 #include <QList>
 #include <QMap>
+#include <QMultiHash>
 #include <QPointF>
+#include <QSet>
+#include <QString>
 
 // C++ include.
 #include <memory>
@@ -29,6 +32,8 @@ class QSharedPointer;
 
 class QTextDocument;
 class QRectF;
+class QPainter;
+class QStyleOptionGraphicsItem;
 QT_END_NAMESPACE
 
 namespace Prototyper
@@ -49,12 +54,14 @@ class TextStyle;
 } /* namespace Cfg */
 
 class Page;
+class FormObject;
 class FormLine;
 class FormText;
 class FormGroup;
 class GridSnap;
 class FormPolyline;
 class PageComment;
+class ImageStore;
 
 //
 // PagePrivate
@@ -64,13 +71,13 @@ class PagePrivate final
 {
 public:
     PagePrivate(Cfg::Page &cfg,
-                const ImagesHash &imagesHash,
+                ImageStore &imageStore,
                 Page *parent)
         : q(parent)
         , m_gridMode(ShowGrid)
         , m_gridStepAction(0)
         , m_cfg(cfg)
-        , m_imagesHash(imagesHash)
+        , m_imageStore(imageStore)
         , m_pressed(false)
         , m_current(0)
         , m_id(0)
@@ -134,6 +141,9 @@ public:
     QList<QGraphicsItem *> selection();
     //! Is comment under mosue?
     bool isCommentUnderMouse() const;
+    //! Draw page with the grid in the exposed rect.
+    void draw(QPainter *painter,
+              const QStyleOptionGraphicsItem *option) const;
 
     //! AlignPoint.
     enum AlignPoint {
@@ -163,8 +173,8 @@ public:
     QAction *m_gridStepAction;
     //! Cfg.
     Cfg::Page &m_cfg;
-    //! Hash of images.
-    ImagesHash m_imagesHash;
+    //! Store of images.
+    ImageStore &m_imageStore;
     //! Pressed.
     bool m_pressed;
     //! Current item.
@@ -183,8 +193,12 @@ public:
     bool m_isCommentChanged;
     //! Current polyline.
     FormPolyline *m_currentPoly;
-    //! IDs
-    QStringList m_ids;
+    //! IDs.
+    QSet<QString> m_ids;
+    //! Objects by IDs, objects of groups included. Kept by objects
+    //! themselves, the ID is shared only while one object takes it
+    //! from another.
+    QMultiHash<QString, FormObject *> m_objects;
     //! Undo stack.
     QUndoStack *m_undoStack;
     //! Map of text documents.
@@ -17,6 +17,7 @@
 #include "object.hpp"
 #include "page.hpp"
 #include "project_cfg.hpp"
+#include "resize_handle.hpp"
 #include "utils.hpp"
 
 // Qt include.
@@ -56,12 +57,14 @@ public:
     void init();
     //! Move by.
     void moveBy(const QPointF &delta);
+    //! \return Items under the point in ascending stacking order.
+    QList<QGraphicsItem *> itemsAt(const QPointF &pos) const;
     //! \return Is something under cursor?
-    bool isSomethingUnderMouse() const;
+    bool isSomethingUnderMouse(const QPointF &pos) const;
     //! \return Item under mouse.
-    QGraphicsItem *itemUnderMouse() const;
+    QGraphicsItem *itemUnderMouse(const QPointF &pos) const;
     //! \return Is handle under mouse?
-    bool isHandleUnderMouse(const QList<QGraphicsItem *> &children) const;
+    bool isHandleUnderMouse(const QPointF &pos) const;
 
     //! Parent.
     PageScene *q;
@@ -87,7 +90,8 @@ public:
 
 void PageScenePrivate::init()
 {
-    q->setItemIndexMethod(QGraphicsScene::NoIndex);
+    // Hit testing queries items at the cursor, it shouldn't depend on count of items.
+    q->setItemIndexMethod(QGraphicsScene::BspTreeIndex);
 }
 
 void PageScenePrivate::moveBy(const QPointF &delta)
@@ -101,12 +105,18 @@ void PageScenePrivate::moveBy(const QPointF &delta)
     }
 }
 
-bool PageScenePrivate::isSomethingUnderMouse() const
+QList<QGraphicsItem *> PageScenePrivate::itemsAt(const QPointF &pos) const
 {
-    const auto children = m_form->childItems();
+    // Invisible items are skipped by the index.
+    return q->items(pos, Qt::IntersectsItemShape, Qt::AscendingOrder);
+}
+
+bool PageScenePrivate::isSomethingUnderMouse(const QPointF &pos) const
+{
+    const auto items = itemsAt(pos);
 
-    for (const auto &item : children) {
-        if (item->isUnderMouse() && item->isVisible()) {
+    for (const auto &item : items) {
+        if (item->parentItem() == m_form) {
             return true;
         }
     }
@@ -114,13 +124,13 @@ bool PageScenePrivate::isSomethingUnderMouse() const
     return false;
 }
 
-QGraphicsItem *PageScenePrivate::itemUnderMouse() const
+QGraphicsItem *PageScenePrivate::itemUnderMouse(const QPointF &pos) const
 {
-    const auto children = m_form->childItems();
+    const auto items = itemsAt(pos);
     QGraphicsItem *selected = nullptr;
 
-    for (const auto &item : children) {
-        if (item->isUnderMouse() && item->isVisible() && dynamic_cast<FormObject *>(item)) {
+    for (const auto &item : items) {
+        if (item->parentItem() == m_form && formObject(item)) {
             if (!selected) {
                 selected = item;
             } else {
@@ -150,28 +160,21 @@ QGraphicsItem *PageScenePrivate::itemUnderMouse() const
     return selected;
 }
 
-bool PageScenePrivate::isHandleUnderMouse(const QList<QGraphicsItem *> &children) const
+bool PageScenePrivate::isHandleUnderMouse(const QPointF &pos) const
 {
-    for (const auto &item : children) {
-        if (item->isUnderMouse() && item->isVisible()) {
-            auto *h = dynamic_cast<FormMoveHandle *>(item);
-            auto *a = dynamic_cast<AspectRatioHandle *>(item);
-            auto *c = dynamic_cast<PageComment *>(item);
-            auto *m = dynamic_cast<NodesEditResizeHandle *>(item);
-
-            if (h || a || c || m) {
-                return true;
-            }
-
-            const auto sub = item->childItems();
-
-            if (!sub.isEmpty()) {
-                const auto subRet = isHandleUnderMouse(sub);
+    const auto items = itemsAt(pos);
+
+    for (const auto &item : items) {
+        switch (item->type()) {
+        case FormMoveHandle::Type:
+        case FormResizeHandle::Type:
+        case AspectRatioHandle::Type:
+        case PageComment::Type:
+        case NodesEditResizeHandle::Type:
+            return true;
 
-                if (subRet) {
-                    return true;
-                }
-            }
+        default:
+            break;
         }
     }
 
@@ -320,7 +323,7 @@ void PageScene::mouseMoveEvent(QGraphicsSceneMouseEvent *event)
 
         bool tmpWasHovered = d->m_wasHandleHovered;
 
-        d->m_wasHandleHovered = d->isHandleUnderMouse(d->m_form->childItems());
+        d->m_wasHandleHovered = d->isHandleUnderMouse(d->m_pos);
 
         if (!d->m_isHandlePressed && !d->m_wasHandleHovered && !tmpWasHovered) {
             event->accept();
@@ -338,12 +341,12 @@ void PageScene::mousePressEvent(QGraphicsSceneMouseEvent *event)
         d->m_isPressedGlobal = true;
     }
 
-    if (d->m_isSelectionEnabled && event->button() == Qt::LeftButton && d->isSomethingUnderMouse()) {
+    if (d->m_isSelectionEnabled && event->button() == Qt::LeftButton && d->isSomethingUnderMouse(event->scenePos())) {
         d->m_isPressed = true;
         d->m_pos = event->scenePos();
         d->m_dist = 0.0;
 
-        if (!d->isHandleUnderMouse(d->m_form->childItems())) {
+        if (!d->isHandleUnderMouse(d->m_pos)) {
             event->accept();
         } else {
             d->m_isHandlePressed = true;
@@ -366,7 +369,7 @@ void PageScene::mouseReleaseEvent(QGraphicsSceneMouseEvent *event)
     if (d->m_isSelectionEnabled && d->m_isPressed && event->button() == Qt::LeftButton) {
         d->m_isPressed = false;
 
-        auto *item = d->itemUnderMouse();
+        auto *item = d->itemUnderMouse(event->scenePos());
 
         if (d->m_dist < c_maxDistNoMove && item && !d->m_isHandlePressed) {
             if (!(event->modifiers() & Qt::ShiftModifier) && !(event->modifiers() & Qt::ControlModifier)) {
@@ -7,12 +7,20 @@
 // Prototyper include.
 #include "page_view.hpp"
 #include "../constants.hpp"
+#include "../exporter/image_cache.hpp"
+#include "../project_bundle.hpp"
+#include "../project_file.hpp"
+#include "../project_index.hpp"
+#include "image.hpp"
+#include "image_store.hpp"
 #include "page.hpp"
 #include "page_scene.hpp"
 #include "project_cfg.hpp"
+#include "utils.hpp"
 
 // Qt include.
 #include <QApplication>
+#include <QUndoStack>
 #include <QWheelEvent>
 
 namespace Prototyper
@@ -21,6 +29,54 @@ namespace Prototyper
 namespace Core
 {
 
+//
+// collectImages
+//
+
+//! Collect handles to images used by the given configuration.
+template<typename CFG>
+void collectImages(const CFG &cfg,
+                   const ImageStore &store,
+                   std::vector<ImageHandle> &used)
+{
+    for (const Cfg::Image &image : cfg.image()) {
+        const auto handle = store.image(image.sha256());
+
+        if (!handle.isNull()) {
+            used.push_back(handle);
+        }
+    }
+
+    for (const Cfg::Group &group : cfg.group()) {
+        collectImages(group, store, used);
+    }
+}
+
+//! Collect encoded images used by the given configuration.
+template<typename CFG>
+void collectImageData(const CFG &cfg,
+                      const ImageStore &store,
+                      ImagesHash &images)
+{
+    for (const Cfg::Image &image : cfg.image()) {
+        if (!images.contains(image.sha256())) {
+            images.insert(image.sha256(), store.image(image.sha256()).data());
+        }
+    }
+
+    for (const Cfg::Group &group : cfg.group()) {
+        collectImageData(group, store, images);
+    }
+}
+
+//! \return Identifier for the new page.
+static quint64 nextPageId()
+{
+    static quint64 id = 0;
+
+    return ++id;
+}
+
 //
 // FormViewPrivate
 //
@@ -29,17 +85,32 @@ class PageViewPrivate
 {
 public:
     PageViewPrivate(const Cfg::Page &cfg,
+                    ImageStore &imageStore,
                     PageView *parent)
         : q(parent)
         , m_scene(nullptr)
         , m_form(nullptr)
         , m_cfg(cfg)
+        , m_imageStore(imageStore)
+        , m_isSerializedValid(false)
+        , m_serializedPrecision(0.0)
+        , m_isIndexPageValid(false)
+        , m_revision(0)
+        , m_id(nextPageId())
+        , m_isLoaded(true)
         , m_scale(1.0)
     {
+        collectImages(m_cfg, m_imageStore, m_images);
     }
 
     //! Init.
-    void init(const ImagesHash &imagesHash);
+    void init();
+    //! Build scene.
+    void materialize();
+    //! Read page from the file if it's not read yet.
+    void load();
+    //! \throw ProjectFileException if the page wasn't read.
+    void checkLoaded();
 
     //! Parent.
     PageView *q;
@@ -49,31 +120,103 @@ public:
     Page *m_form;
     //! Cfg.
     Cfg::Page m_cfg;
+    //! Store of images.
+    ImageStore &m_imageStore;
+    //! Images used on the page while it's not materialized.
+    std::vector<ImageHandle> m_images;
+    //! Serialized page.
+    QString m_serialized;
+    //! Does m_serialized match the page?
+    bool m_isSerializedValid;
+    //! Precision m_serialized was made with.
+    qreal m_serializedPrecision;
+    //! Entry of the project's index.
+    ProjectIndexPage m_indexPage;
+    //! Does m_indexPage match the page?
+    bool m_isIndexPageValid;
+    //! Revision, incremented on every change.
+    quint64 m_revision;
+    //! Identifier, unique in the application's run.
+    quint64 m_id;
+    //! Page file in the project bundle.
+    QString m_pageFile;
+    //! Is page read from m_pageFile?
+    bool m_isLoaded;
+    //! Error of reading m_pageFile, empty if the page was read.
+    QString m_loadError;
     //! Scale.
     qreal m_scale;
 }; // class FormViewPrivate
 
-void PageViewPrivate::init(const ImagesHash &imagesHash)
+void PageViewPrivate::init()
 {
     q->setFrameStyle(QFrame::NoFrame);
 
+    q->setRubberBandSelectionMode(Qt::ContainsItemShape);
+
+    q->setRenderHints(QPainter::Antialiasing);
+
+    q->setAcceptDrops(true);
+}
+
+void PageViewPrivate::materialize()
+{
+    load();
+
     m_scene = new PageScene(m_cfg, q);
 
     q->setScene(m_scene);
 
-    m_form = new Page(m_cfg, imagesHash);
+    m_form = new Page(m_cfg, m_imageStore);
 
     m_form->setCfg(m_cfg);
 
     m_scene->setPage(m_form);
 
-    q->setRubberBandSelectionMode(Qt::ContainsItemShape);
+    // Items of the page reference images from now on.
+    m_images.clear();
+
+    // Any command, undo or redo changes the page.
+    PageView::connect(m_form->undoStack(), &QUndoStack::indexChanged, q, &PageView::invalidateSerialized);
+    PageView::connect(m_form, &Page::changed, q, &PageView::invalidateSerialized);
 
     q->enableSelection(true);
+}
 
-    q->setRenderHints(QPainter::Antialiasing);
+void PageViewPrivate::load()
+{
+    if (m_isLoaded) {
+        return;
+    }
 
-    q->setAcceptDrops(true);
+    m_isLoaded = true;
+
+    try {
+        Cfg::Page cfg = readBundlePage(m_pageFile);
+
+        // Name of the page is kept in the manifest.
+        cfg.set_tabName(m_cfg.tabName());
+
+        m_cfg = cfg;
+
+        collectImages(m_cfg, m_imageStore, m_images);
+    } catch (const ProjectFileException &x) {
+        // Page is shown empty but never written instead of the content of the file.
+        m_loadError = x.what();
+
+        m_cfg.size().set_width(c_a4Width);
+        m_cfg.size().set_height(c_a4Height);
+    }
+}
+
+void PageViewPrivate::checkLoaded()
+{
+    load();
+
+    if (!m_loadError.isEmpty()) {
+        throw ProjectFileException(
+            PageView::tr("Page \"%1\" wasn't read from \"%2\".\n%3").arg(m_cfg.tabName(), m_pageFile, m_loadError));
+    }
 }
 
 //
@@ -81,17 +224,76 @@ void PageViewPrivate::init(const ImagesHash &imagesHash)
 //
 
 PageView::PageView(const Cfg::Page &cfg,
-                   const ImagesHash &imagesHash,
+                   ImageStore &imageStore,
                    QWidget *parent)
     : QGraphicsView(parent)
     , d(new PageViewPrivate(cfg,
+                            imageStore,
                             this))
 {
-    d->init(imagesHash);
+    d->init();
 }
 
 PageView::~PageView() = default;
 
+bool PageView::isMaterialized() const
+{
+    return (d->m_form != nullptr);
+}
+
+void PageView::materialize()
+{
+    if (!isMaterialized()) {
+        d->materialize();
+
+        emit materialized();
+    }
+}
+
+void PageView::dematerialize()
+{
+    if (isMaterialized()) {
+        // Page and scene keep references to m_cfg, so copy first.
+        const Cfg::Page cfg = d->m_form->cfg();
+
+        // Keep images alive while items are destroyed.
+        collectImages(cfg, d->m_imageStore, d->m_images);
+
+        setScene(nullptr);
+
+        delete d->m_scene;
+
+        d->m_scene = nullptr;
+        d->m_form = nullptr;
+
+        d->m_cfg = cfg;
+
+        emit dematerialized();
+    }
+}
+
+qint64 PageView::memoryUsage() const
+{
+    qint64 bytes = 0;
+
+    if (isMaterialized()) {
+        const auto items = d->m_scene->items();
+
+        for (const auto &item : items) {
+            bytes += c_pageItemMemoryCost;
+
+            const auto *image = dynamic_cast<const FormImage *>(item);
+
+            if (image) {
+                // Source image and the scaled pixmap.
+                bytes += image->image().sizeInBytes() * 2;
+            }
+        }
+    }
+
+    return bytes;
+}
+
 PageScene *PageView::pageScene() const
 {
     return d->m_scene;
@@ -102,9 +304,117 @@ Page *PageView::page() const
     return d->m_form;
 }
 
+Cfg::Page PageView::cfg() const
+{
+    d->checkLoaded();
+
+    if (isMaterialized()) {
+        return d->m_form->cfg();
+    } else {
+        return d->m_cfg;
+    }
+}
+
+QString PageView::serialized(qreal precision)
+{
+    // Comments are changed without commands.
+    if (isMaterialized() && d->m_form->isCommentChanged()) {
+        d->m_isSerializedValid = false;
+        d->m_isIndexPageValid = false;
+    }
+
+    if (!d->m_isSerializedValid || d->m_serializedPrecision != precision) {
+        d->m_serialized = serializePage(cfg(), precision);
+        d->m_serializedPrecision = precision;
+        d->m_isSerializedValid = true;
+    }
+
+    return d->m_serialized;
+}
+
+const ProjectIndexPage &PageView::indexPage()
+{
+    if (isMaterialized() && d->m_form->isCommentChanged()) {
+        d->m_isSerializedValid = false;
+        d->m_isIndexPageValid = false;
+    }
+
+    if (!d->m_isIndexPageValid) {
+        const Cfg::Page page = cfg();
+
+        ImagesHash hash;
+        collectImageData(page, d->m_imageStore, hash);
+
+        ImageCache images(hash);
+
+        d->m_indexPage = makeIndexPage(page, images);
+        d->m_isIndexPageValid = true;
+    }
+
+    return d->m_indexPage;
+}
+
+void PageView::loadOnDemand(const QString &fileName)
+{
+    d->m_pageFile = fileName;
+    d->m_isLoaded = false;
+}
+
+bool PageView::isLoaded() const
+{
+    return d->m_isLoaded;
+}
+
+const QString &PageView::loadError() const
+{
+    return d->m_loadError;
+}
+
+const QString &PageView::pageFile() const
+{
+    return d->m_pageFile;
+}
+
+void PageView::setPageFile(const QString &fileName)
+{
+    d->m_pageFile = fileName;
+}
+
+void PageView::invalidateSerialized()
+{
+    d->m_isSerializedValid = false;
+    d->m_isIndexPageValid = false;
+
+    ++d->m_revision;
+}
+
+quint64 PageView::revision() const
+{
+    return d->m_revision;
+}
+
+quint64 PageView::id() const
+{
+    return d->m_id;
+}
+
+void PageView::setGridStep(int s)
+{
+    if (isMaterialized()) {
+        d->m_form->setGridStep(s);
+    } else {
+        d->load();
+        d->m_cfg.set_gridStep(MmPx::instance().toMmX(s));
+    }
+
+    invalidateSerialized();
+}
+
 void PageView::enableSelection(bool on)
 {
-    d->m_scene->enableSelection(on);
+    if (d->m_scene) {
+        d->m_scene->enableSelection(on);
+    }
 
     if (on) {
         setDragMode(QGraphicsView::RubberBandDrag);
@@ -31,6 +31,8 @@ class Page;
 
 class PageScene;
 class Page;
+class ImageStore;
+struct ProjectIndexPage;
 
 //
 // PageView
@@ -46,19 +48,68 @@ class PageView final : public QGraphicsView
 signals:
     //! Zoom changed.
     void zoomChanged();
+    //! Page's scene was built.
+    void materialized();
+    //! Page's scene was destroyed.
+    void dematerialized();
 
 public:
     PageView(const Cfg::Page &cfg,
-             const ImagesHash &imagesHash,
+             ImageStore &imageStore,
              QWidget *parent = 0);
     ~PageView() override;
 
-    //! \return Page scene.
+    //! \return Is page's scene built?
+    bool isMaterialized() const;
+    //! Build page's scene from the stored configuration if it's not built yet.
+    void materialize();
+    //! Store page's configuration and destroy the scene.
+    void dematerialize();
+    //! \return Approximate memory used by the page's scene, in bytes.
+    qint64 memoryUsage() const;
+
+    //! \return Page scene. Null till the page is materialized.
     PageScene *pageScene() const;
 
-    //! \return Form.
+    //! \return Form. Null till the page is materialized.
     Page *page() const;
 
+    //! Read the page from the file of the project bundle on first use,
+    //! till then the page holds its name only.
+    void loadOnDemand(const QString &fileName);
+    //! \return Is page read?
+    bool isLoaded() const;
+    //! \return Error of reading the page, empty if there is no one. Page
+    //! that wasn't read is shown empty and can't be saved.
+    const QString &loadError() const;
+    //! \return Page file in the project bundle, empty if there is no one.
+    const QString &pageFile() const;
+    //! Set page file the page was saved to.
+    void setPageFile(const QString &fileName);
+
+    //! \return Configuration of the page.
+    //! \throw ProjectFileException if the page wasn't read.
+    Cfg::Page cfg() const;
+    //! \return Page serialized for the text project file. Text is reused
+    //! till the page or precision changes.
+    //! \param precision Precision of the project.
+    //! \throw ProjectFileException on error.
+    QString serialized(qreal precision);
+    //! \return Entry of the project's index for the page, it's reused
+    //! while the page isn't changed.
+    //! \throw ProjectFileException if the page wasn't read.
+    const ProjectIndexPage &indexPage();
+    //! Drop serialized text, page was changed not through its undo stack.
+    void invalidateSerialized();
+    //! \return Revision of the page, it's incremented on every change.
+    quint64 revision() const;
+    //! \return Identifier of the page, it's never reused by other pages
+    //! unlike the address of the page.
+    quint64 id() const;
+
+    //! Set grid step.
+    void setGridStep(int s);
+
     //! Enable/disable selection.
     void enableSelection(bool on = true);
 
@@ -53,6 +53,14 @@ public:
         return PolylineType;
     }
 
+    //! Type of the graphics item.
+    enum { Type = FormObjectItemType + PolylineType };
+
+    int type() const override
+    {
+        return Type;
+    }
+
     //! \return Cfg.
     Cfg::Polyline cfg() const;
     //! Set cfg.
@@ -37,6 +37,14 @@ public:
         return RadioButtonType;
     }
 
+    //! Type of the graphics item.
+    enum { Type = FormObjectItemType + RadioButtonType };
+
+    int type() const override
+    {
+        return Type;
+    }
+
     void paint(QPainter *painter,
                const QStyleOptionGraphicsItem *option,
                QWidget *widget = 0) override;
@@ -75,6 +75,8 @@ FormRectPlacer::~FormRectPlacer() = default;
 
 void FormRectPlacer::setStartPos(const QPointF &pos)
 {
+    prepareGeometryChange();
+
     d->m_startPos = pos;
     d->m_rect = QRectF(pos.x(), pos.y(), 0.0, 0.0);
 
@@ -90,6 +92,8 @@ void FormRectPlacer::setEndPos(const QPointF &pos)
 {
     const QRectF tmp = d->m_rect.adjusted(-20.0, -20.0, 20.0, 20.0);
 
+    prepareGeometryChange();
+
     d->m_width = pos.x() - d->m_startPos.x();
     d->m_height = pos.y() - d->m_startPos.y();
 
@@ -13,6 +13,9 @@
 // C++ include.
 #include <memory>
 
+// Prototyper include.
+#include "../types.hpp"
+
 namespace Prototyper
 {
 
@@ -32,6 +35,14 @@ public:
     explicit FormRectPlacer(QGraphicsItem *parent);
     ~FormRectPlacer();
 
+    //! Type of the graphics item.
+    enum { Type = RectPlacerItemType };
+
+    int type() const override
+    {
+        return Type;
+    }
+
     //! Set start pos.
     void setStartPos(const QPointF &pos);
 
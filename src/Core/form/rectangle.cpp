@@ -69,6 +69,8 @@ void FormRectPrivate::init()
 
 void FormRectPrivate::updateRect(const QRectF &r)
 {
+    q->prepareGeometryChange();
+
     m_rect = r;
 
     m_rect.moveTopLeft(QPointF(0.0, 0.0));
@@ -226,6 +228,9 @@ void FormRect::setObjectPen(const QPen &p,
     QPen newPen = p;
     newPen.setWidth(2);
 
+    // Bounding rectangle includes the pen.
+    prepareGeometryChange();
+
     FormObject::setObjectPen(newPen, pushUndoCommand);
 
     update();
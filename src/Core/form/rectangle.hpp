@@ -46,6 +46,14 @@ public:
         return RectType;
     }
 
+    //! Type of the graphics item.
+    enum { Type = FormObjectItemType + RectType };
+
+    int type() const override
+    {
+        return Type;
+    }
+
     //! \return Cfg.
     Cfg::Rect cfg() const;
     //! Set cfg.
@@ -87,6 +95,8 @@ protected:
     void handleReleased(FormMoveHandle *handle) override;
 
 private:
+    friend class FormRectPrivate;
+
     Q_DISABLE_COPY(FormRect)
 
     std::unique_ptr<FormRectPrivate> d;
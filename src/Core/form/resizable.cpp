@@ -124,6 +124,8 @@ void FormResizableProxy::setRect(const QRectF &rect)
 {
     const QRectF tmp = d->m_rect.adjusted(-20.0, -20.0, 20.0, 20.0);
 
+    prepareGeometryChange();
+
     d->m_rect = rect;
 
     setPos(d->m_rect.topLeft());
@@ -14,6 +14,7 @@
 #include <memory>
 
 // Prototyper include.
+#include "../types.hpp"
 #include "move_handle.hpp"
 #include "with_resize_and_move_handles.hpp"
 
@@ -64,6 +65,14 @@ public:
                        Page *form);
     ~FormResizableProxy() override;
 
+    //! Type of the graphics item.
+    enum { Type = ResizableProxyItemType };
+
+    int type() const override
+    {
+        return Type;
+    }
+
     //! Set rect.
     void setRect(const QRectF &rect);
 
@@ -35,6 +35,14 @@ public:
                      const QCursor &c = Qt::SizeAllCursor);
     ~FormResizeHandle() override;
 
+    //! Type of the graphics item.
+    enum { Type = ResizeHandleItemType };
+
+    int type() const override
+    {
+        return Type;
+    }
+
     void paint(QPainter *painter,
                const QStyleOptionGraphicsItem *option,
                QWidget *widget = 0) override;
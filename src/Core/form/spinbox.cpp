@@ -98,10 +98,14 @@ void FormSpinBoxPrivate::init()
     q->setObjectPen(QPen(PageAction::instance()->strokeColor()), false);
 
     q->setObjectBrush(QBrush(PageAction::instance()->fillColor()), false);
+
+    q->setCacheMode(PageAction::instance()->widgetCacheMode());
 }
 
 void FormSpinBoxPrivate::setRect(const QRectF &rect)
 {
+    q->prepareGeometryChange();
+
     m_rect = rect;
 
     q->setPos(m_rect.topLeft());
@@ -414,6 +418,8 @@ void FormSpinBox::resize(const QRectF &rect)
 {
     d->setRect(rect);
 
+    update();
+
     page()->update();
 }
 
@@ -49,6 +49,14 @@ public:
         return SpinBoxType;
     }
 
+    //! Type of the graphics item.
+    enum { Type = FormObjectItemType + SpinBoxType };
+
+    int type() const override
+    {
+        return Type;
+    }
+
     void paint(QPainter *painter,
                const QStyleOptionGraphicsItem *option,
                QWidget *widget = 0) override;
@@ -49,6 +49,14 @@ public:
         return TextType;
     }
 
+    //! Type of the graphics item.
+    enum { Type = FormObjectItemType + TextType };
+
+    int type() const override
+    {
+        return Type;
+    }
+
     //! \return Cfg.
     Cfg::Text cfg() const;
     //! Set cfg.
@@ -404,10 +404,19 @@ qreal MmPx::fromMmY(qreal mm) const
     return ((m_ydots / c_mmInInch) * mm);
 }
 
+//! DPI used when there is no screen, i.e. in the headless mode.
+static const qreal c_noScreenDpi = 96.0;
+
 MmPx::MmPx()
-    : m_xdots(qApp->primaryScreen()->physicalDotsPerInchX())
-    , m_ydots(qApp->primaryScreen()->physicalDotsPerInchY())
+    : m_xdots(c_noScreenDpi)
+    , m_ydots(c_noScreenDpi)
 {
+    const QScreen *screen = (qApp ? QGuiApplication::primaryScreen() : nullptr);
+
+    if (screen) {
+        m_xdots = screen->physicalDotsPerInchX();
+        m_ydots = screen->physicalDotsPerInchY();
+    }
 }
 
 QSizeF MmPx::a4() const
@@ -43,6 +43,9 @@ minMaxZ(const QList<QGraphicsItem *> &items);
 // MmPx
 //
 
+//! Converter between millimeters, points and pixels.
+//! Instance is immutable after construction and may be used from any thread,
+//! but first call of instance() should be done on the GUI thread.
 class MmPx final
 {
 public:
@@ -62,10 +62,14 @@ void FormVSliderPrivate::init()
     q->setObjectPen(QPen(PageAction::instance()->strokeColor()), false);
 
     q->setObjectBrush(Qt::transparent, false);
+
+    q->setCacheMode(PageAction::instance()->widgetCacheMode());
 }
 
 void FormVSliderPrivate::setRect(const QRectF &rect)
 {
+    q->prepareGeometryChange();
+
     m_rect = rect;
 
     q->setPos(m_rect.topLeft());
@@ -240,6 +244,8 @@ void FormVSlider::resize(const QRectF &rect)
 {
     d->setRect(rect);
 
+    update();
+
     page()->update();
 }
 
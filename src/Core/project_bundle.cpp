@@ -0,0 +1,293 @@
+
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// Prototyper include.
+#include "project_bundle.hpp"
+#include "project_file.hpp"
+
+// Qt include.
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QObject>
+#include <QSaveFile>
+#include <QSet>
+#include <QTextStream>
+#include <QUuid>
+
+namespace Prototyper
+{
+
+namespace Core
+{
+
+static const QString c_manifestFileName = QStringLiteral("manifest.prototyperm");
+static const QString c_pagesDirName = QStringLiteral("pages");
+static const QString c_imagesDirName = QStringLiteral("images");
+static const QString c_pageFileSuffix = QStringLiteral(".page");
+
+//! Write file atomically.
+//! \throw ProjectFileException on error.
+static void writeFile(const QString &fileName,
+                      const QByteArray &data)
+{
+    QSaveFile file(fileName);
+
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit()) {
+        throw ProjectFileException(QObject::tr("Unable to write \"%1\".\n%2").arg(fileName, file.errorString()));
+    }
+}
+
+//! Remove files of the directory not listed in \a used.
+static void removeUnused(const QString &dir,
+                         const QSet<QString> &used)
+{
+    const QStringList files = QDir(dir).entryList(QDir::Files);
+
+    for (const auto &file : files) {
+        if (!used.contains(file)) {
+            QFile::remove(dir + QLatin1Char('/') + file);
+        }
+    }
+}
+
+bool isProjectBundle(const QString &path)
+{
+    return (QFileInfo(path).isDir() && QFileInfo::exists(path + QLatin1Char('/') + c_manifestFileName));
+}
+
+QString projectBundleDir(const QString &path)
+{
+    const QFileInfo info(path);
+
+    if (info.fileName() == c_manifestFileName) {
+        return info.absolutePath();
+    }
+
+    return path;
+}
+
+QString newBundlePageFile()
+{
+    return QUuid::createUuid().toString(QUuid::WithoutBraces) + c_pageFileSuffix;
+}
+
+QString bundlePageFile(const QString &dir,
+                       const QString &file)
+{
+    return dir + QLatin1Char('/') + c_pagesDirName + QLatin1Char('/') + file;
+}
+
+QString bundleImageFile(const QString &sha256,
+                        const QString &format)
+{
+    // Base64 has '/', hex is safe for file names.
+    return QString::fromLatin1(QByteArray::fromBase64(sha256.toLatin1()).toHex()) + QLatin1Char('.')
+        + format.toLower();
+}
+
+QString bundleImageFile(const QString &dir,
+                        const QString &sha256,
+                        const QString &format)
+{
+    return dir + QLatin1Char('/') + c_imagesDirName + QLatin1Char('/') + bundleImageFile(sha256, format);
+}
+
+Cfg::Project readBundleManifest(const QString &dir,
+                                ProjectBundle &bundle)
+{
+    QFile file(dir + QLatin1Char('/') + c_manifestFileName);
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        throw ProjectFileException(QObject::tr("Unable to open manifest of the project bundle."));
+    }
+
+    Cfg::Bundle manifest;
+
+    try {
+        Cfg::tag_Bundle<cfgfile::qstring_trait_t> tag;
+
+        QTextStream stream(&file);
+
+        cfgfile::read_cfgfile(tag, stream, file.fileName());
+
+        manifest = tag.get_cfg();
+    } catch (const cfgfile::exception_t<cfgfile::qstring_trait_t> &x) {
+        throw ProjectFileException(x.desc());
+    }
+
+    Cfg::Project cfg;
+    cfg.set_description(manifest.description());
+    cfg.set_defaultGridStep(manifest.defaultGridStep());
+    cfg.set_showGrid(manifest.showGrid());
+    cfg.set_precision(manifest.precision());
+
+    bundle = ProjectBundle();
+
+    for (const auto &page : manifest.page()) {
+        Cfg::Page p;
+        p.set_tabName(page.tabName());
+
+        cfg.page().push_back(p);
+
+        bundle.m_pages.insert(page.tabName(), bundlePageFile(dir, page.file()));
+    }
+
+    const QFileInfoList images =
+        QDir(dir + QLatin1Char('/') + c_imagesDirName).entryInfoList(QDir::Files, QDir::Name);
+
+    for (const auto &image : images) {
+        const QString sha256 = QString::fromLatin1(QByteArray::fromHex(image.completeBaseName().toLatin1()).toBase64());
+
+        bundle.m_images.insert(sha256, image.absoluteFilePath());
+    }
+
+    return cfg;
+}
+
+Cfg::Page readBundlePage(const QString &fileName)
+{
+    QFile file(fileName);
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        throw ProjectFileException(QObject::tr("Unable to open page file \"%1\".").arg(fileName));
+    }
+
+    return deserializePage(QString::fromUtf8(file.readAll()));
+}
+
+Cfg::ImageData readBundleImage(const QString &sha256,
+                               const QString &fileName)
+{
+    QFile file(fileName);
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        throw ProjectFileException(QObject::tr("Unable to open image file \"%1\".").arg(fileName));
+    }
+
+    Cfg::ImageData image;
+    image.set_sha256(sha256);
+    image.set_format(QFileInfo(fileName).suffix().toUpper());
+    image.set_data(QString::fromLatin1(file.readAll().toBase64()));
+
+    return image;
+}
+
+Cfg::Project readBundle(const QString &dir)
+{
+    ProjectBundle bundle;
+
+    Cfg::Project cfg = readBundleManifest(dir, bundle);
+
+    for (auto &page : cfg.page()) {
+        page = readBundlePage(bundle.m_pages.value(page.tabName()));
+    }
+
+    for (auto it = bundle.m_images.cbegin(), last = bundle.m_images.cend(); it != last; ++it) {
+        cfg.images().push_back(readBundleImage(it.key(), it.value()));
+    }
+
+    return cfg;
+}
+
+void writeBundle(const QString &dir,
+                 const ProjectBundleChanges &changes)
+{
+    const QString pagesDir = dir + QLatin1Char('/') + c_pagesDirName;
+    const QString imagesDir = dir + QLatin1Char('/') + c_imagesDirName;
+
+    if (!QDir().mkpath(pagesDir) || !QDir().mkpath(imagesDir)) {
+        throw ProjectFileException(QObject::tr("Unable to create directory \"%1\".").arg(dir));
+    }
+
+    // Saved pages stay untouched until the manifest switches to the new files.
+    for (const auto &page : changes.m_changed) {
+        const QString fileName = bundlePageFile(dir, page.first);
+
+        if (QFileInfo::exists(fileName)) {
+            throw ProjectFileException(QObject::tr("Page file \"%1\" already exists.").arg(fileName));
+        }
+
+        writeFile(fileName, page.second.toUtf8());
+    }
+
+    for (const auto &image : changes.m_newImages) {
+        const QString fileName = bundleImageFile(dir, image.sha256(), image.format());
+
+        // Content-addressed, present file is the same image.
+        if (!QFileInfo::exists(fileName)) {
+            writeFile(fileName, QByteArray::fromBase64(image.data().toLatin1()));
+        }
+    }
+
+    Cfg::Bundle manifest;
+    manifest.set_description(changes.m_cfg.description());
+    manifest.set_defaultGridStep(changes.m_cfg.defaultGridStep());
+    manifest.set_showGrid(changes.m_cfg.showGrid());
+    manifest.set_precision(changes.m_cfg.precision());
+
+    QSet<QString> pages;
+
+    for (const auto &page : changes.m_pages) {
+        Cfg::BundlePage p;
+        p.set_tabName(page.first);
+        p.set_file(page.second);
+
+        manifest.page().push_back(p);
+
+        pages.insert(page.second);
+    }
+
+    try {
+        Cfg::tag_Bundle<cfgfile::qstring_trait_t> tag(manifest);
+
+        // The bundle switches to the new files here.
+        writeFile(dir + QLatin1Char('/') + c_manifestFileName,
+                  compactNumbers(tag.print()).toUtf8());
+    } catch (const cfgfile::exception_t<cfgfile::qstring_trait_t> &x) {
+        throw ProjectFileException(x.desc());
+    }
+
+    removeUnused(pagesDir, pages);
+}
+
+void removeUnusedBundleImages(const QString &dir,
+                              const QStringList &files)
+{
+    removeUnused(dir + QLatin1Char('/') + c_imagesDirName, QSet<QString>(files.cbegin(), files.cend()));
+}
+
+void writeBundle(const QString &dir,
+                 const Cfg::Project &cfg)
+{
+    ProjectBundleChanges changes;
+    changes.m_cfg = cfg;
+    changes.m_cfg.page().clear();
+    changes.m_cfg.images().clear();
+
+    for (const auto &page : cfg.page()) {
+        const QString file = newBundlePageFile();
+
+        changes.m_pages.append(qMakePair(page.tabName(), file));
+        changes.m_changed.append(qMakePair(file, serializePage(page, cfg.precision())));
+    }
+
+    changes.m_newImages = cfg.images();
+
+    writeBundle(dir, changes);
+
+    QStringList images;
+
+    for (const auto &image : cfg.images()) {
+        images.append(bundleImageFile(image.sha256(), image.format()));
+    }
+
+    removeUnusedBundleImages(dir, images);
+}
+
+} /* namespace Core */
+
+} /* namespace Prototyper */
@@ -0,0 +1,135 @@
+
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#ifndef PROTOTYPER__CORE__PROJECT_BUNDLE_HPP__INCLUDED
+#define PROTOTYPER__CORE__PROJECT_BUNDLE_HPP__INCLUDED
+
+// Qt include.
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+
+// C++ include.
+#include <vector>
+
+// Prototyper include.
+#include "project_cfg.hpp"
+
+namespace Prototyper
+{
+
+namespace Core
+{
+
+/*
+    Project bundle is a directory:
+
+        manifest.prototyperm - description, grid options and pages in order
+                               with their files;
+        pages/               - one file per page, the page as it's placed
+                               into the text project file;
+        images/              - encoded images named by hex SHA-256 of the
+                               data with the format as the suffix.
+
+    Pages and images are read on demand. Changed pages are written to new
+    files, images are never rewritten. The manifest is written last and
+    switches to the new files, page files not listed there are removed after.
+*/
+
+//
+// ProjectBundle
+//
+
+//! Files of the opened bundle.
+struct ProjectBundle {
+    //! Page files keyed by tab names.
+    QHash<QString, QString> m_pages;
+    //! Image files keyed by SHA-256.
+    QHash<QString, QString> m_images;
+}; // struct ProjectBundle
+
+//
+// ProjectBundleChanges
+//
+
+//! Changes of the project to write into the bundle.
+struct ProjectBundleChanges {
+    //! Project without pages and images.
+    Cfg::Project m_cfg;
+    //! Tab names and files of all pages in order.
+    QList<QPair<QString, QString>> m_pages;
+    //! Changed pages: new file and serialized page.
+    QList<QPair<QString, QString>> m_changed;
+    //! Images not present in the bundle.
+    std::vector<Cfg::ImageData> m_newImages;
+}; // struct ProjectBundleChanges
+
+//! \return Is it a directory of the project bundle?
+bool isProjectBundle(const QString &path);
+
+//! \return Bundle directory for the given path, it's the path itself or
+//! the bundle's manifest.
+QString projectBundleDir(const QString &path);
+
+//! \return Name for a new page file.
+QString newBundlePageFile();
+
+//! \return Absolute name of the page file.
+QString bundlePageFile(const QString &dir,
+                       const QString &file);
+
+//! \return Name of the image file relative to the images directory.
+QString bundleImageFile(const QString &sha256,
+                        const QString &format);
+
+//! \return Absolute name of the image file.
+QString bundleImageFile(const QString &dir,
+                        const QString &sha256,
+                        const QString &format);
+
+//! Read manifest of the bundle. Pages of the result hold tab names only,
+//! there are no images.
+//! \throw ProjectFileException on error.
+Cfg::Project readBundleManifest(const QString &dir,
+                                ProjectBundle &bundle);
+
+//! Read page file.
+//! \throw ProjectFileException on error.
+Cfg::Page readBundlePage(const QString &fileName);
+
+//! \return Encoded image read from the file.
+//! \throw ProjectFileException on error.
+Cfg::ImageData readBundleImage(const QString &sha256,
+                               const QString &fileName);
+
+//! Read the whole bundle.
+//! \throw ProjectFileException on error.
+Cfg::Project readBundle(const QString &dir);
+
+//! Write changes into the bundle, page files not used anymore are removed.
+//! Changed pages must go to files not present in the bundle.
+//! Images are kept, a pending save may still refer to them.
+//! \throw ProjectFileException on error.
+void writeBundle(const QString &dir,
+                 const ProjectBundleChanges &changes);
+
+//! Remove images of the bundle not listed in \a files, names are relative
+//! to the images directory.
+void removeUnusedBundleImages(const QString &dir,
+                              const QStringList &files);
+
+//! Write the whole project as a bundle.
+//! \throw ProjectFileException on error.
+void writeBundle(const QString &dir,
+                 const Cfg::Project &cfg);
+
+} /* namespace Core */
+
+} /* namespace Prototyper */
+
+#endif // PROTOTYPER__CORE__PROJECT_BUNDLE_HPP__INCLUDED
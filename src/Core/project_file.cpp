@@ -0,0 +1,589 @@
+
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// Prototyper include.
+#include "project_file.hpp"
+#include "binary_project.hpp"
+#include "compressed_device.hpp"
+#include "project_bundle.hpp"
+#include "project_cfg.hpp"
+#include "project_index.hpp"
+
+// Qt include.
+#include <QFile>
+#include <QLocale>
+#include <QObject>
+#include <QTextStream>
+
+// C++ include.
+#include <cmath>
+#include <vector>
+
+namespace Prototyper
+{
+
+namespace Core
+{
+
+static const QString c_textProjectExtension = QStringLiteral(".prototyper");
+static const QString c_binaryProjectExtension = QStringLiteral(".prototyperb");
+static const QString c_compressedProjectExtension = QStringLiteral(".prototyperz");
+static const QString c_bundleProjectExtension = QStringLiteral(".prototyperd");
+
+//! \return Is it a tag holding real number?
+static bool isRealTag(QStringView name)
+{
+    static const QStringList names = {QStringLiteral("x"),
+                                      QStringLiteral("y"),
+                                      QStringLiteral("width"),
+                                      QStringLiteral("height"),
+                                      QStringLiteral("textWidth"),
+                                      QStringLiteral("gridStep"),
+                                      QStringLiteral("defaultGridStep"),
+                                      QStringLiteral("z"),
+                                      QStringLiteral("fontSize"),
+                                      QStringLiteral("precision")};
+
+    return names.contains(name);
+}
+
+//! \return Length rounded to the step.
+static qreal quantize(qreal v,
+                      qreal precision)
+{
+    const qreal steps = std::round(v / precision);
+    const qreal perUnit = std::round(1.0 / precision);
+
+    // Division by the whole count of steps per unit gives the double nearest to the decimal.
+    if (perUnit > 0.0 && std::abs(perUnit * precision - 1.0) < 1e-12) {
+        return steps / perUnit;
+    }
+
+    // Product carries the rounding error, 15 significant digits drop it.
+    return QString::number(steps * precision, 'g', 15).toDouble();
+}
+
+static void quantizeGeometry(Cfg::Group &group,
+                             qreal precision);
+
+static void quantizeGeometry(Cfg::Point &point,
+                             qreal precision)
+{
+    point.set_x(quantize(point.x(), precision));
+    point.set_y(quantize(point.y(), precision));
+}
+
+static void quantizeGeometry(Cfg::Size &size,
+                             qreal precision)
+{
+    size.set_width(quantize(size.width(), precision));
+    size.set_height(quantize(size.height(), precision));
+}
+
+static void quantizeGeometry(Cfg::Line &line,
+                             qreal precision)
+{
+    quantizeGeometry(line.p1(), precision);
+    quantizeGeometry(line.p2(), precision);
+    quantizeGeometry(line.pos(), precision);
+}
+
+static void quantizeGeometry(Cfg::Polyline &poly,
+                             qreal precision)
+{
+    for (auto &line : poly.line()) {
+        quantizeGeometry(line, precision);
+    }
+
+    quantizeGeometry(poly.pos(), precision);
+    quantizeGeometry(poly.size(), precision);
+}
+
+static void quantizeGeometry(Cfg::Text &text,
+                             qreal precision)
+{
+    quantizeGeometry(text.pos(), precision);
+
+    text.set_textWidth(quantize(text.textWidth(), precision));
+}
+
+static void quantizeGeometry(Cfg::Rect &rect,
+                             qreal precision)
+{
+    quantizeGeometry(rect.topLeft(), precision);
+    quantizeGeometry(rect.size(), precision);
+    quantizeGeometry(rect.pos(), precision);
+}
+
+static void quantizeGeometry(Cfg::CheckBox &checkbox,
+                             qreal precision)
+{
+    quantizeGeometry(checkbox.pos(), precision);
+    quantizeGeometry(checkbox.size(), precision);
+
+    checkbox.set_width(quantize(checkbox.width(), precision));
+}
+
+//! Quantize position and size of the image or the widget.
+template<typename CFG>
+static void quantizeGeometry(CFG &cfg,
+                             qreal precision)
+{
+    quantizeGeometry(cfg.pos(), precision);
+    quantizeGeometry(cfg.size(), precision);
+}
+
+//! Quantize elements of the page or the group.
+template<typename CFG>
+static void quantizeElements(CFG &cfg,
+                             qreal precision)
+{
+    for (auto &line : cfg.line()) {
+        quantizeGeometry(line, precision);
+    }
+
+    for (auto &poly : cfg.polyline()) {
+        quantizeGeometry(poly, precision);
+    }
+
+    for (auto &text : cfg.text()) {
+        quantizeGeometry(text, precision);
+    }
+
+    for (auto &image : cfg.image()) {
+        quantizeGeometry(image, precision);
+    }
+
+    for (auto &rect : cfg.rect()) {
+        quantizeGeometry(rect, precision);
+    }
+
+    for (auto &button : cfg.button()) {
+        quantizeGeometry(button, precision);
+    }
+
+    for (auto &checkbox : cfg.checkbox()) {
+        quantizeGeometry(checkbox, precision);
+    }
+
+    for (auto &radio : cfg.radiobutton()) {
+        quantizeGeometry(radio, precision);
+    }
+
+    for (auto &combo : cfg.combobox()) {
+        quantizeGeometry(combo, precision);
+    }
+
+    for (auto &spin : cfg.spinbox()) {
+        quantizeGeometry(spin, precision);
+    }
+
+    for (auto &slider : cfg.hslider()) {
+        quantizeGeometry(slider, precision);
+    }
+
+    for (auto &slider : cfg.vslider()) {
+        quantizeGeometry(slider, precision);
+    }
+
+    for (auto &group : cfg.group()) {
+        quantizeGeometry(group, precision);
+    }
+}
+
+static void quantizeGeometry(Cfg::Group &group,
+                             qreal precision)
+{
+    quantizeElements(group, precision);
+
+    quantizeGeometry(group.pos(), precision);
+}
+
+//! Write data to the device.
+//! \throw ProjectFileException on error.
+static void writeData(QIODevice &device,
+                      const QByteArray &data)
+{
+    if (device.write(data) != data.size()) {
+        throw ProjectFileException(QObject::tr("Unable to write project.\n%1").arg(device.errorString()));
+    }
+}
+
+//! \return Size of the text in UTF-8.
+static qint64 utf8Size(QStringView text)
+{
+    qint64 size = 0;
+
+    for (qsizetype i = 0; i < text.size(); ++i) {
+        const char16_t c = text.at(i).unicode();
+
+        if (c < 0x80) {
+            size += 1;
+        } else if (c < 0x800) {
+            size += 2;
+        } else if (QChar::isHighSurrogate(c) && i + 1 < text.size()
+                   && QChar::isLowSurrogate(text.at(i + 1).unicode())) {
+            size += 4;
+            ++i;
+        } else {
+            size += 3;
+        }
+    }
+
+    return size;
+}
+
+//! \return Image serialized for the text project file.
+//! \throw cfgfile::exception_t on error.
+static QString serializeImage(const Cfg::ImageData &image)
+{
+    Cfg::tag_ImageData<cfgfile::qstring_trait_t> tag(image);
+
+    // Standalone tag is named by the class, in the project it's named by the member.
+    QString text = tag.print(1);
+
+    static const QString className = QStringLiteral("ImageData");
+    static const QString name = QStringLiteral("images");
+
+    text.replace(text.indexOf(QLatin1Char('{')) + 1, className.size(), name);
+
+    return text;
+}
+
+void quantizeGeometry(Cfg::Page &page,
+                      qreal precision)
+{
+    if (precision <= 0.0) {
+        return;
+    }
+
+    quantizeGeometry(page.size(), precision);
+
+    quantizeElements(page, precision);
+
+    for (auto &comments : page.comments()) {
+        quantizeGeometry(comments.pos(), precision);
+    }
+}
+
+QString compactNumbers(const QString &text)
+{
+    // cfgfile prints every digit of the double.
+    QString res;
+    res.reserve(text.size());
+
+    const QStringView view(text);
+    const qsizetype size = text.size();
+    bool quoted = false;
+    qsizetype i = 0;
+
+    while (i < size) {
+        const QChar c = text.at(i);
+
+        res.append(c);
+        ++i;
+
+        if (quoted) {
+            if (c == QLatin1Char('\\') && i < size) {
+                res.append(text.at(i));
+                ++i;
+            } else if (c == QLatin1Char('"')) {
+                quoted = false;
+            }
+
+            continue;
+        }
+
+        if (c == QLatin1Char('"')) {
+            quoted = true;
+
+            continue;
+        }
+
+        if (c != QLatin1Char('{')) {
+            continue;
+        }
+
+        qsizetype nameEnd = i;
+
+        while (nameEnd < size && (text.at(nameEnd).isLetterOrNumber() || text.at(nameEnd) == QLatin1Char('_'))) {
+            ++nameEnd;
+        }
+
+        if (nameEnd == size || text.at(nameEnd) != QLatin1Char(' ') || !isRealTag(view.mid(i, nameEnd - i))) {
+            continue;
+        }
+
+        const qsizetype valueStart = nameEnd + 1;
+        const qsizetype valueEnd = text.indexOf(QLatin1Char('}'), valueStart);
+
+        if (valueEnd < 0) {
+            continue;
+        }
+
+        bool ok = false;
+        const double v = view.mid(valueStart, valueEnd - valueStart).toDouble(&ok);
+
+        if (!ok) {
+            continue;
+        }
+
+        res.append(view.mid(i, valueStart - i));
+        res.append(QString::number(v, 'g', QLocale::FloatingPointShortest));
+
+        i = valueEnd;
+    }
+
+    return res;
+}
+
+ProjectFormat projectFormatForFileName(const QString &fileName)
+{
+    if (fileName.endsWith(c_binaryProjectExtension, Qt::CaseInsensitive)) {
+        return BinaryProjectFormat;
+    } else if (fileName.endsWith(c_compressedProjectExtension, Qt::CaseInsensitive)) {
+        return CompressedProjectFormat;
+    } else if (fileName.endsWith(c_bundleProjectExtension, Qt::CaseInsensitive)) {
+        return BundleProjectFormat;
+    } else {
+        return TextProjectFormat;
+    }
+}
+
+QString projectFileExtension(ProjectFormat format)
+{
+    switch (format) {
+    case BinaryProjectFormat:
+        return c_binaryProjectExtension;
+
+    case CompressedProjectFormat:
+        return c_compressedProjectExtension;
+
+    case BundleProjectFormat:
+        return c_bundleProjectExtension;
+
+    default:
+        return c_textProjectExtension;
+    }
+}
+
+Cfg::Project readProjectFile(const QString &fileName)
+{
+    if (isProjectBundle(fileName)) {
+        return readBundle(fileName);
+    }
+
+    QFile file(fileName);
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        throw ProjectFileException(QObject::tr("Unable to open file."));
+    }
+
+    return readProjectFile(file, fileName);
+}
+
+Cfg::Project readProjectFile(QIODevice &device,
+                             const QString &fileName)
+{
+    if (isCompressedStream(device.peek(2))) {
+        InflateDevice inflate(device);
+
+        if (!inflate.open(QIODevice::ReadOnly)) {
+            throw ProjectFileException(inflate.errorString());
+        }
+
+        return readProjectFile(inflate, fileName);
+    }
+
+    if (isBinaryProject(device.peek(binaryProjectMagicSize()))) {
+        return readBinaryProject(device);
+    }
+
+    try {
+        Cfg::tag_Project<cfgfile::qstring_trait_t> tag;
+
+        QTextStream stream(&device);
+
+        cfgfile::read_cfgfile(tag, stream, fileName);
+
+        return tag.get_cfg();
+    } catch (const cfgfile::exception_t<cfgfile::qstring_trait_t> &x) {
+        throw ProjectFileException(x.desc());
+    }
+}
+
+void writeProjectFile(const Cfg::Project &cfg,
+                      QIODevice &device,
+                      ProjectFormat format,
+                      const ProjectIndex *index)
+{
+    ProjectIndex made;
+
+    if (!index && format != BundleProjectFormat) {
+        made = makeProjectIndex(cfg);
+        index = &made;
+    }
+
+    switch (format) {
+    case BinaryProjectFormat: {
+        writeBinaryProject(cfg, device, index);
+    } break;
+
+    case BundleProjectFormat:
+        throw ProjectFileException(QObject::tr("Project bundle can't be written into a file."));
+
+    default: {
+        QStringList pages;
+        pages.reserve(qsizetype(cfg.page().size()));
+
+        for (const auto &page : cfg.page()) {
+            pages.append(serializePage(page, cfg.precision()));
+        }
+
+        writeTextProject(cfg, pages, device, format, index);
+    } break;
+    }
+}
+
+QString serializePage(const Cfg::Page &page,
+                      qreal precision)
+{
+    if (precision > 0.0) {
+        Cfg::Page quantized = page;
+        quantizeGeometry(quantized, precision);
+
+        return serializePage(quantized);
+    }
+
+    try {
+        Cfg::tag_Page<cfgfile::qstring_trait_t> tag(page);
+
+        // Standalone tag is named by the class, in the project it's named
+        // by the member and is nested one level deep.
+        QString text = tag.print(1);
+
+        static const QString name = QStringLiteral("page");
+
+        text.replace(text.indexOf(QLatin1Char('{')) + 1, name.size(), name);
+
+        return compactNumbers(text);
+    } catch (const cfgfile::exception_t<cfgfile::qstring_trait_t> &x) {
+        throw ProjectFileException(x.desc());
+    }
+}
+
+Cfg::Page deserializePage(const QString &text)
+{
+    try {
+        QString t = text;
+
+        static const QString name = QStringLiteral("Page");
+
+        t.replace(t.indexOf(QLatin1Char('{')) + 1, name.size(), name);
+
+        Cfg::tag_Page<cfgfile::qstring_trait_t> tag;
+
+        QTextStream stream(&t, QIODevice::ReadOnly);
+
+        cfgfile::read_cfgfile(tag, stream, name);
+
+        return tag.get_cfg();
+    } catch (const cfgfile::exception_t<cfgfile::qstring_trait_t> &x) {
+        throw ProjectFileException(x.desc());
+    }
+}
+
+void writeTextProject(const Cfg::Project &cfg,
+                      const QStringList &pages,
+                      QIODevice &device,
+                      ProjectFormat format,
+                      const ProjectIndex *index)
+{
+    if (format == CompressedProjectFormat) {
+        // Text goes through the compressor as it's written.
+        DeflateDevice deflate(device);
+
+        if (!deflate.open(QIODevice::WriteOnly)) {
+            throw ProjectFileException(deflate.errorString());
+        }
+
+        writeTextProject(cfg, pages, deflate, TextProjectFormat, index);
+
+        if (!deflate.finish()) {
+            throw ProjectFileException(deflate.errorString());
+        }
+
+        return;
+    }
+
+    try {
+        // Pages and images are the bulk of the project, they're written one by one.
+        Cfg::Project c;
+        c.set_description(cfg.description());
+        c.set_defaultGridStep(cfg.defaultGridStep());
+        c.set_showGrid(cfg.showGrid());
+        c.set_precision(cfg.precision());
+
+        Cfg::tag_Project<cfgfile::qstring_trait_t> tag(c);
+
+        const QString text = compactNumbers(tag.print());
+
+        // Order of tags doesn't matter, pages and then images are placed
+        // before the closing brace of the project. Images after pages
+        // aren't read to reach a page by the index.
+        const auto end = text.lastIndexOf(QLatin1Char('}'));
+
+        const QByteArray head = QStringView(text).left(end).toUtf8();
+
+        if (index) {
+            ProjectIndex i = *index;
+            i.m_pages.resize(std::size_t(pages.size()));
+
+            qint64 offset = head.size();
+
+            for (std::size_t p = 0; p < i.m_pages.size(); ++p) {
+                i.m_pages[p].m_offset = offset;
+                i.m_pages[p].m_size = utf8Size(pages.at(qsizetype(p)));
+
+                offset += i.m_pages[p].m_size;
+            }
+
+            writeData(device, printTextIndex(i));
+        }
+
+        writeData(device, head);
+
+        for (const auto &page : pages) {
+            writeData(device, page.toUtf8());
+        }
+
+        for (const auto &image : cfg.images()) {
+            writeData(device, serializeImage(image).toUtf8());
+        }
+
+        writeData(device, QStringView(text).mid(end).toUtf8());
+    } catch (const cfgfile::exception_t<cfgfile::qstring_trait_t> &x) {
+        throw ProjectFileException(x.desc());
+    }
+}
+
+//
+// ProjectFileException
+//
+
+ProjectFileException::ProjectFileException(const QString &w)
+    : m_what(w)
+{
+}
+
+const QString &ProjectFileException::what() const noexcept
+{
+    return m_what;
+}
+
+} /* namespace Core */
+
+} /* namespace Prototyper */
@@ -0,0 +1,125 @@
+
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#ifndef PROTOTYPER__CORE__PROJECT_FILE_HPP__INCLUDED
+#define PROTOTYPER__CORE__PROJECT_FILE_HPP__INCLUDED
+
+// Qt include.
+#include <QString>
+#include <QStringList>
+
+QT_BEGIN_NAMESPACE
+class QIODevice;
+QT_END_NAMESPACE
+
+namespace Prototyper
+{
+
+namespace Core
+{
+
+namespace Cfg
+{
+
+class Project;
+class Page;
+
+} /* namespace Cfg */
+
+struct ProjectIndex;
+
+//
+// ProjectFormat
+//
+
+//! Format of the project file.
+enum ProjectFormat {
+    //! cfgfile text.
+    TextProjectFormat = 1,
+    //! Chunked binary.
+    BinaryProjectFormat = 2,
+    //! cfgfile text in gzip stream.
+    CompressedProjectFormat = 3,
+    //! Directory with manifest, page files and image files.
+    BundleProjectFormat = 4
+}; // enum ProjectFormat
+
+//! \return Format of the project file by its extension.
+ProjectFormat projectFormatForFileName(const QString &fileName);
+
+//! \return Extension of the project file with the leading dot.
+QString projectFileExtension(ProjectFormat format);
+
+//! Read project, format is detected by the content of the file.
+//! Project bundle is read as a whole.
+//! \throw ProjectFileException on error.
+Cfg::Project readProjectFile(const QString &fileName);
+
+//! Read project from the opened device, format is detected by the content.
+//! Compressed project is decompressed while it's read.
+//! \throw ProjectFileException on error.
+Cfg::Project readProjectFile(QIODevice &device,
+                             const QString &fileName);
+
+//! Write project in the given format, project bundle is written by writeBundle().
+//! \param index Index placed at the head of the file, it's made from \a cfg if null.
+//! \throw ProjectFileException on error.
+void writeProjectFile(const Cfg::Project &cfg,
+                      QIODevice &device,
+                      ProjectFormat format,
+                      const ProjectIndex *index = nullptr);
+
+//! Round positions and sizes of the page and its elements to \a precision,
+//! zero keeps them exact. Pen widths, Z values, font and grid steps are kept.
+void quantizeGeometry(Cfg::Page &page,
+                      qreal precision);
+
+//! \return Page serialized exactly as it's placed into the text project file.
+//! \param precision Step geometry is rounded to, see quantizeGeometry().
+//! \throw ProjectFileException on error.
+QString serializePage(const Cfg::Page &page,
+                      qreal precision = 0.0);
+
+//! \return Text printed by cfgfile with real numbers rewritten in the
+//! shortest form that reads back to the same value.
+QString compactNumbers(const QString &text);
+
+//! \return Page read from the text made by serializePage().
+//! \throw ProjectFileException on error.
+Cfg::Page deserializePage(const QString &text);
+
+//! Write project in text format with already serialized pages,
+//! pages of \a cfg are ignored. Pages should be serialized with
+//! precision of the project.
+//! \param format Text or compressed text.
+//! \param index Index placed at the head of the file, offsets are filled.
+//! \throw ProjectFileException on error.
+void writeTextProject(const Cfg::Project &cfg,
+                      const QStringList &pages,
+                      QIODevice &device,
+                      ProjectFormat format = TextProjectFormat,
+                      const ProjectIndex *index = nullptr);
+
+//
+// ProjectFileException
+//
+
+class ProjectFileException final
+{
+public:
+    explicit ProjectFileException(const QString &w);
+
+    const QString &what() const noexcept;
+
+private:
+    QString m_what;
+}; // class ProjectFileException
+
+} /* namespace Core */
+
+} /* namespace Prototyper */
+
+#endif // PROTOTYPER__CORE__PROJECT_FILE_HPP__INCLUDED
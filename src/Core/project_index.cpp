@@ -0,0 +1,246 @@
+
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// Prototyper include.
+#include "project_index.hpp"
+#include "binary_project.hpp"
+#include "compressed_device.hpp"
+#include "exporter/exporter.hpp"
+#include "exporter/image_cache.hpp"
+#include "project_file.hpp"
+
+// Qt include.
+#include <QBuffer>
+#include <QFile>
+#include <QIODevice>
+#include <QImage>
+#include <QObject>
+
+namespace Prototyper
+{
+
+namespace Core
+{
+
+static const QByteArray c_textIndexHeader = QByteArrayLiteral("|# Prototyper index ");
+static const QByteArray c_textIndexFooter = QByteArrayLiteral("#|");
+static const QByteArray c_textIndexPage = QByteArrayLiteral("page");
+static const int c_textIndexVersion = 1;
+
+//! Longest side of the thumbnail in pixels.
+static const int c_thumbnailSize = 128;
+
+//! \return Count of elements of the page or the group.
+template<typename CFG>
+int elementsCount(const CFG &cfg)
+{
+    int count = int(cfg.line().size() + cfg.polyline().size() + cfg.text().size() + cfg.image().size()
+                    + cfg.rect().size() + cfg.button().size() + cfg.checkbox().size() + cfg.radiobutton().size()
+                    + cfg.combobox().size() + cfg.spinbox().size() + cfg.hslider().size() + cfg.vslider().size()
+                    + cfg.group().size());
+
+    for (const auto &group : cfg.group()) {
+        count += elementsCount(group);
+    }
+
+    return count;
+}
+
+//! \return Line without the line break.
+static QByteArray chopLineBreak(QByteArray line)
+{
+    while (line.endsWith('\n') || line.endsWith('\r')) {
+        line.chop(1);
+    }
+
+    return line;
+}
+
+int pageElementsCount(const Cfg::Page &page)
+{
+    return elementsCount(page);
+}
+
+ProjectIndexPage makeIndexPage(const Cfg::Page &page,
+                               ImageCache &images)
+{
+    ProjectIndexPage res;
+    res.m_tabName = page.tabName();
+    res.m_elements = pageElementsCount(page);
+
+    const QImage thumbnail = renderPageThumbnail(page, images, c_thumbnailSize);
+
+    if (!thumbnail.isNull()) {
+        QBuffer buffer(&res.m_thumbnail);
+        buffer.open(QIODevice::WriteOnly);
+
+        thumbnail.save(&buffer, "PNG");
+    }
+
+    return res;
+}
+
+ProjectIndex makeProjectIndex(const Cfg::Project &cfg)
+{
+    ImagesHash hash;
+
+    for (const auto &image : cfg.images()) {
+        hash.insert(image.sha256(), image);
+    }
+
+    ImageCache images(hash);
+
+    ProjectIndex index;
+    index.m_pages.reserve(cfg.page().size());
+
+    for (const auto &page : cfg.page()) {
+        index.m_pages.push_back(makeIndexPage(page, images));
+    }
+
+    return index;
+}
+
+QByteArray printTextIndex(const ProjectIndex &index)
+{
+    QByteArray res = c_textIndexHeader + QByteArray::number(c_textIndexVersion) + '\n';
+
+    // Nothing in the entries may close the comment, names are percent-encoded.
+    for (const auto &page : index.m_pages) {
+        res += c_textIndexPage + ' ' + QByteArray::number(page.m_offset) + ' ' + QByteArray::number(page.m_size) + ' '
+            + QByteArray::number(page.m_elements) + ' ' + page.m_tabName.toUtf8().toPercentEncoding() + ' '
+            + page.m_thumbnail.toBase64() + '\n';
+    }
+
+    res += c_textIndexFooter + '\n';
+
+    return res;
+}
+
+bool readTextIndex(QIODevice &device,
+                   ProjectIndex &index)
+{
+    const QByteArray head = device.peek(c_textIndexHeader.size() + 16);
+
+    if (!head.startsWith(c_textIndexHeader)) {
+        return false;
+    }
+
+    bool ok = false;
+    const int version = head.mid(c_textIndexHeader.size()).split('\n').constFirst().trimmed().toInt(&ok);
+
+    // Index is a comment, project is readable without it.
+    if (!ok || version > c_textIndexVersion) {
+        return false;
+    }
+
+    device.readLine();
+
+    index.m_pages.clear();
+
+    while (true) {
+        const QByteArray line = chopLineBreak(device.readLine());
+
+        if (line == c_textIndexFooter) {
+            return true;
+        }
+
+        const QList<QByteArray> fields = line.split(' ');
+
+        if (fields.size() != 6 || fields.at(0) != c_textIndexPage) {
+            throw ProjectFileException(QObject::tr("Index of the project is corrupted."));
+        }
+
+        ProjectIndexPage page;
+        bool offsetOk = false;
+        bool sizeOk = false;
+        bool elementsOk = false;
+
+        page.m_offset = fields.at(1).toLongLong(&offsetOk);
+        page.m_size = fields.at(2).toLongLong(&sizeOk);
+        page.m_elements = fields.at(3).toInt(&elementsOk);
+        page.m_tabName = QString::fromUtf8(QByteArray::fromPercentEncoding(fields.at(4)));
+        page.m_thumbnail = QByteArray::fromBase64(fields.at(5));
+
+        if (!offsetOk || !sizeOk || !elementsOk) {
+            throw ProjectFileException(QObject::tr("Index of the project is corrupted."));
+        }
+
+        index.m_pages.push_back(page);
+    }
+}
+
+bool readProjectIndex(const QString &fileName,
+                      ProjectIndex &index)
+{
+    QFile file(fileName);
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        throw ProjectFileException(QObject::tr("Unable to open file."));
+    }
+
+    if (isCompressedStream(file.peek(2))) {
+        // Only the head of the stream is decompressed.
+        InflateDevice inflate(file);
+
+        if (!inflate.open(QIODevice::ReadOnly)) {
+            throw ProjectFileException(inflate.errorString());
+        }
+
+        return readTextIndex(inflate, index);
+    } else if (isBinaryProject(file.peek(binaryProjectMagicSize()))) {
+        return readBinaryProjectIndex(file, index);
+    } else {
+        return readTextIndex(file, index);
+    }
+}
+
+Cfg::Page readIndexedPage(const QString &fileName,
+                          const ProjectIndexPage &page)
+{
+    QFile file(fileName);
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        throw ProjectFileException(QObject::tr("Unable to open file."));
+    }
+
+    if (isBinaryProject(file.peek(binaryProjectMagicSize()))) {
+        return readBinaryProjectPage(file, page.m_offset);
+    }
+
+    InflateDevice inflate(file);
+    QIODevice *device = &file;
+
+    if (isCompressedStream(file.peek(2))) {
+        if (!inflate.open(QIODevice::ReadOnly)) {
+            throw ProjectFileException(inflate.errorString());
+        }
+
+        device = &inflate;
+    }
+
+    ProjectIndex index;
+
+    if (!readTextIndex(*device, index)) {
+        throw ProjectFileException(QObject::tr("Project has no index."));
+    }
+
+    // The compressed stream is decompressed up to the page.
+    if (device->skip(page.m_offset) != page.m_offset) {
+        throw ProjectFileException(QObject::tr("Index of the project is corrupted."));
+    }
+
+    const QByteArray data = device->read(page.m_size);
+
+    if (data.size() != page.m_size) {
+        throw ProjectFileException(QObject::tr("Index of the project is corrupted."));
+    }
+
+    return deserializePage(QString::fromUtf8(data));
+}
+
+} /* namespace Core */
+
+} /* namespace Prototyper */
@@ -0,0 +1,112 @@
+
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#ifndef PROTOTYPER__CORE__PROJECT_INDEX_HPP__INCLUDED
+#define PROTOTYPER__CORE__PROJECT_INDEX_HPP__INCLUDED
+
+// Qt include.
+#include <QByteArray>
+#include <QString>
+
+// C++ include.
+#include <vector>
+
+// Prototyper include.
+#include "project_cfg.hpp"
+
+QT_BEGIN_NAMESPACE
+class QIODevice;
+QT_END_NAMESPACE
+
+namespace Prototyper
+{
+
+namespace Core
+{
+
+class ImageCache;
+
+/*
+    Index is the table of contents placed at the head of the project file,
+    it lets to list pages and to read one page without parsing the project.
+
+    In the binary project it's the "TOC " chunk, offsets there are of the
+    "PAGE" chunks from the start of the file.
+
+    In the text project it's a comment before the project:
+
+        |# Prototyper index 1
+        page <offset> <size> <elements> <percent-encoded name> <base64 PNG>
+        #|
+
+    Offsets there are of the pages' UTF-8 text from the end of the comment,
+    for the compressed project they are in the decompressed stream.
+*/
+
+//
+// ProjectIndexPage
+//
+
+//! Entry of the index for one page.
+struct ProjectIndexPage {
+    //! Tab name.
+    QString m_tabName;
+    //! Offset of the page's data, filled on writing.
+    qint64 m_offset = 0;
+    //! Size of the page's data, filled on writing.
+    qint64 m_size = 0;
+    //! Count of elements on the page, elements of groups included.
+    int m_elements = 0;
+    //! Thumbnail in PNG.
+    QByteArray m_thumbnail;
+}; // struct ProjectIndexPage
+
+//
+// ProjectIndex
+//
+
+//! Index of the project.
+struct ProjectIndex {
+    //! Pages in order.
+    std::vector<ProjectIndexPage> m_pages;
+}; // struct ProjectIndex
+
+//! \return Count of elements on the page, elements of groups included.
+int pageElementsCount(const Cfg::Page &page);
+
+//! \return Entry of the index for the page, offsets aren't filled.
+ProjectIndexPage makeIndexPage(const Cfg::Page &page,
+                               ImageCache &images);
+
+//! \return Index of the project, offsets aren't filled.
+ProjectIndex makeProjectIndex(const Cfg::Project &cfg);
+
+//! \return Text index, offsets are relative to its end.
+QByteArray printTextIndex(const ProjectIndex &index);
+
+//! Read text index from the head of the device, the device is left
+//! at the end of the index.
+//! \return Was index found?
+//! \throw ProjectFileException on error.
+bool readTextIndex(QIODevice &device,
+                   ProjectIndex &index);
+
+//! Read index of the project file.
+//! \return Has the file an index?
+//! \throw ProjectFileException on error.
+bool readProjectIndex(const QString &fileName,
+                      ProjectIndex &index);
+
+//! \return Page of the project file read by its entry in the index.
+//! \throw ProjectFileException on error.
+Cfg::Page readIndexedPage(const QString &fileName,
+                          const ProjectIndexPage &page);
+
+} /* namespace Core */
+
+} /* namespace Prototyper */
+
+#endif // PROTOTYPER__CORE__PROJECT_INDEX_HPP__INCLUDED
@@ -0,0 +1,411 @@
+
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// Prototyper include.
+#include "project_journal.hpp"
+#include "binary_project.hpp"
+#include "project_file.hpp"
+
+// Qt include.
+#include <QBuffer>
+#include <QDataStream>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QObject>
+#include <QSaveFile>
+#include <QThreadPool>
+
+// C++ include.
+#include <vector>
+
+#ifdef Q_OS_WIN
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace Prototyper
+{
+
+namespace Core
+{
+
+static const QByteArray c_journalMagic = QByteArrayLiteral("PRTJ");
+static const quint16 c_journalVersion = 1;
+static const QString c_journalExtension = QStringLiteral(".journal");
+
+//! Setup stream for the journal.
+static inline void setupStream(QDataStream &s)
+{
+    s.setVersion(QDataStream::Qt_6_0);
+    s.setByteOrder(QDataStream::LittleEndian);
+}
+
+//! \return Size of the journal's header.
+static inline qint64 headerSize()
+{
+    return c_journalMagic.size() + qint64(sizeof(c_journalVersion));
+}
+
+//! Write header of the journal.
+static void writeHeader(QIODevice &device)
+{
+    QDataStream out(&device);
+    setupStream(out);
+
+    out.writeRawData(c_journalMagic.constData(), c_journalMagic.size());
+    out << c_journalVersion;
+}
+
+//! Flush the file down to the disk, so records survive a crash of the system.
+//! \return Is it flushed?
+static bool syncToDisk(QFile &file)
+{
+    if (!file.flush()) {
+        return false;
+    }
+
+#ifdef Q_OS_WIN
+    return (::_commit(file.handle()) == 0);
+#else
+    return (::fsync(file.handle()) == 0);
+#endif
+}
+
+//! \return Encoded record with size and checksum.
+static QByteArray encodeRecord(const ProjectJournalRecord &record)
+{
+    QByteArray project;
+    QBuffer buffer(&project);
+    buffer.open(QIODevice::WriteOnly);
+
+    writeBinaryProject(record.m_project, buffer);
+
+    QByteArray payload;
+
+    {
+        QDataStream s(&payload, QIODevice::WriteOnly);
+        setupStream(s);
+
+        s << project << record.m_pages << quint32(record.m_changed.size());
+
+        for (const auto &page : record.m_changed) {
+            s << page.first << page.second;
+        }
+    }
+
+    QByteArray res;
+
+    QDataStream out(&res, QIODevice::WriteOnly);
+    setupStream(out);
+
+    out << quint32(payload.size());
+    out.writeRawData(payload.constData(), payload.size());
+    out << quint16(qChecksum(payload));
+
+    return res;
+}
+
+//! \return Approximate size of the encoded record.
+static qint64 recordSize(const ProjectJournalRecord &record)
+{
+    qint64 size = 1024;
+
+    for (const auto &page : record.m_changed) {
+        size += (page.first.size() + page.second.size()) * 2;
+    }
+
+    for (const auto &image : record.m_project.images()) {
+        size += image.data().size();
+    }
+
+    return size;
+}
+
+//
+// ProjectJournalPrivate
+//
+
+class ProjectJournalPrivate
+{
+public:
+    ProjectJournalPrivate()
+        : m_size(0)
+    {
+        m_pool.setMaxThreadCount(1);
+    }
+
+    //! Worker.
+    QThreadPool m_pool;
+    //! Journal file.
+    QString m_fileName;
+    //! Approximate size of the journal.
+    qint64 m_size;
+}; // class ProjectJournalPrivate
+
+//
+// ProjectJournal
+//
+
+ProjectJournal::ProjectJournal()
+    : d(new ProjectJournalPrivate)
+{
+}
+
+ProjectJournal::~ProjectJournal()
+{
+    d->m_pool.waitForDone();
+}
+
+QString ProjectJournal::fileName(const QString &projectFileName)
+{
+    return projectFileName + c_journalExtension;
+}
+
+bool ProjectJournal::exists(const QString &projectFileName)
+{
+    return (QFileInfo(fileName(projectFileName)).size() > headerSize());
+}
+
+void ProjectJournal::open(const QString &projectFileName)
+{
+    const QString journal = fileName(projectFileName);
+
+    if (d->m_fileName != journal) {
+        d->m_fileName = journal;
+        d->m_size = QFileInfo(journal).size();
+    }
+}
+
+void ProjectJournal::close()
+{
+    d->m_fileName.clear();
+    d->m_size = 0;
+}
+
+void ProjectJournal::discard()
+{
+    if (isOpen()) {
+        const QString journal = d->m_fileName;
+
+        d->m_pool.start([journal]() {
+            QFile::remove(journal);
+        });
+
+        close();
+    }
+}
+
+bool ProjectJournal::isOpen() const
+{
+    return !d->m_fileName.isEmpty();
+}
+
+void ProjectJournal::append(const ProjectJournalRecord &record)
+{
+    if (isOpen()) {
+        d->m_size += recordSize(record);
+
+        const QString journal = d->m_fileName;
+
+        d->m_pool.start([journal, record]() {
+            try {
+                const QByteArray data = encodeRecord(record);
+
+                QFile file(journal);
+
+                if (file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+                    if (file.size() == 0) {
+                        writeHeader(file);
+                    }
+
+                    file.write(data);
+
+                    syncToDisk(file);
+                }
+            } catch (const ProjectFileException &) {
+                // Next record carries the changes again.
+            }
+        });
+    }
+}
+
+void ProjectJournal::checkpoint(const ProjectJournalRecord &record)
+{
+    if (isOpen()) {
+        d->m_size = recordSize(record);
+
+        const QString journal = d->m_fileName;
+
+        d->m_pool.start([journal, record]() {
+            try {
+                const QByteArray data = encodeRecord(record);
+
+                QSaveFile file(journal);
+
+                if (file.open(QIODevice::WriteOnly)) {
+                    writeHeader(file);
+
+                    file.write(data);
+                    file.commit();
+                }
+            } catch (const ProjectFileException &) {
+                // Previous records are kept.
+            }
+        });
+    }
+}
+
+qint64 ProjectJournal::size() const
+{
+    return d->m_size;
+}
+
+void ProjectJournal::waitForDone()
+{
+    d->m_pool.waitForDone();
+}
+
+//
+// replayJournal
+//
+
+Cfg::Project replayJournal(const Cfg::Project &saved,
+                           const QString &journalFileName,
+                           QStringList *changedPages)
+{
+    QFile file(journalFileName);
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        throw ProjectFileException(QObject::tr("Unable to open journal."));
+    }
+
+    QDataStream in(&file);
+    setupStream(in);
+
+    QByteArray magic(c_journalMagic.size(), 0);
+    in.readRawData(magic.data(), magic.size());
+
+    quint16 version = 0;
+    in >> version;
+
+    if (in.status() != QDataStream::Ok || magic != c_journalMagic) {
+        throw ProjectFileException(QObject::tr("Not a journal."));
+    }
+
+    if (version > c_journalVersion) {
+        throw ProjectFileException(QObject::tr("Unsupported version %1 of the journal.").arg(version));
+    }
+
+    Cfg::Project res = saved;
+
+    QStringList names;
+
+    for (const auto &page : saved.page()) {
+        names.append(page.tabName());
+    }
+
+    QHash<QString, QString> changed;
+
+    while (!in.atEnd()) {
+        quint32 size = 0;
+        in >> size;
+
+        if (in.status() != QDataStream::Ok || size > quint64(file.size() - file.pos())) {
+            break;
+        }
+
+        QByteArray payload(qsizetype(size), Qt::Uninitialized);
+
+        quint16 checksum = 0;
+
+        if (in.readRawData(payload.data(), payload.size()) != payload.size()) {
+            break;
+        }
+
+        in >> checksum;
+
+        // Torn record, the rest wasn't written.
+        if (in.status() != QDataStream::Ok || checksum != qChecksum(payload)) {
+            break;
+        }
+
+        QDataStream s(payload);
+        setupStream(s);
+
+        QByteArray project;
+        QStringList pages;
+        quint32 count = 0;
+
+        s >> project >> pages >> count;
+
+        QHash<QString, QString> pagesInRecord;
+
+        for (quint32 i = 0; i < count && s.status() == QDataStream::Ok; ++i) {
+            QString name;
+            QString text;
+            s >> name >> text;
+
+            pagesInRecord.insert(name, text);
+        }
+
+        if (s.status() != QDataStream::Ok) {
+            break;
+        }
+
+        QBuffer buffer(&project);
+        buffer.open(QIODevice::ReadOnly);
+
+        const Cfg::Project p = readBinaryProject(buffer);
+
+        res.set_description(p.description());
+        res.set_defaultGridStep(p.defaultGridStep());
+        res.set_showGrid(p.showGrid());
+        res.set_precision(p.precision());
+
+        for (const auto &image : p.images()) {
+            res.images().push_back(image);
+        }
+
+        names = pages;
+
+        for (auto it = pagesInRecord.cbegin(), last = pagesInRecord.cend(); it != last; ++it) {
+            changed.insert(it.key(), it.value());
+        }
+    }
+
+    QHash<QString, const Cfg::Page *> savedPages;
+
+    for (const auto &page : saved.page()) {
+        savedPages.insert(page.tabName(), &page);
+    }
+
+    std::vector<Cfg::Page> pages;
+    pages.reserve(names.size());
+
+    for (const auto &name : std::as_const(names)) {
+        const auto it = changed.constFind(name);
+
+        if (it != changed.cend()) {
+            pages.push_back(deserializePage(it.value()));
+
+            if (changedPages) {
+                changedPages->append(name);
+            }
+        } else if (savedPages.contains(name)) {
+            pages.push_back(*savedPages.value(name));
+        }
+    }
+
+    res.page() = pages;
+
+    return res;
+}
+
+} /* namespace Core */
+
+} /* namespace Prototyper */
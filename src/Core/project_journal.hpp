@@ -0,0 +1,112 @@
+
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#ifndef PROTOTYPER__CORE__PROJECT_JOURNAL_HPP__INCLUDED
+#define PROTOTYPER__CORE__PROJECT_JOURNAL_HPP__INCLUDED
+
+// Qt include.
+#include <QList>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+
+// C++ include.
+#include <memory>
+
+// Prototyper include.
+#include "project_cfg.hpp"
+
+namespace Prototyper
+{
+
+namespace Core
+{
+
+/*
+    Journal is a header followed by records, it's placed beside the project
+    file and holds changes made after the last save.
+
+    Header: magic "PRTJ", quint16 version.
+    Record: quint32 size of the payload, payload, quint16 checksum of the payload.
+
+    Payload: binary project without pages holding description, grid options
+    and images not written before, names of all pages in order, count of
+    changed pages and for each of them its name and serialized page.
+
+    Pages not changed since the last save are taken from the project file by
+    name. Torn record at the end is ignored.
+*/
+
+//
+// ProjectJournalRecord
+//
+
+//! Changes of the project to append to the journal.
+struct ProjectJournalRecord {
+    //! Project without pages, with images not written before.
+    Cfg::Project m_project;
+    //! Names of all pages in order.
+    QStringList m_pages;
+    //! Changed pages: name and serialized page.
+    QList<QPair<QString, QString>> m_changed;
+}; // struct ProjectJournalRecord
+
+//
+// ProjectJournal
+//
+
+class ProjectJournalPrivate;
+
+//! Append-only journal of unsaved changes, written on a worker thread.
+class ProjectJournal final
+{
+public:
+    ProjectJournal();
+    ~ProjectJournal();
+
+    //! \return Journal file of the project.
+    static QString fileName(const QString &projectFileName);
+    //! \return Is there a journal with changes of the project?
+    static bool exists(const QString &projectFileName);
+
+    //! Write journal of the given project from now on.
+    void open(const QString &projectFileName);
+    //! Stop writing, journal is kept.
+    void close();
+    //! Stop writing and remove the journal.
+    void discard();
+    //! \return Is journal open?
+    bool isOpen() const;
+
+    //! Append record.
+    void append(const ProjectJournalRecord &record);
+    //! Replace the journal with the single record.
+    void checkpoint(const ProjectJournalRecord &record);
+
+    //! \return Approximate size of the journal, in bytes.
+    qint64 size() const;
+
+    //! Block till all writes are done.
+    void waitForDone();
+
+private:
+    Q_DISABLE_COPY(ProjectJournal)
+
+    std::unique_ptr<ProjectJournalPrivate> d;
+}; // class ProjectJournal
+
+//! Apply journal onto the saved project.
+//! \param changedPages Names of pages taken from the journal.
+//! \throw ProjectFileException on error.
+Cfg::Project replayJournal(const Cfg::Project &saved,
+                           const QString &journalFileName,
+                           QStringList *changedPages = nullptr);
+
+} /* namespace Core */
+
+} /* namespace Prototyper */
+
+#endif // PROTOTYPER__CORE__PROJECT_JOURNAL_HPP__INCLUDED
@@ -0,0 +1,356 @@
+
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// Prototyper include.
+#include "project_loader.hpp"
+#include "form/image_store.hpp"
+#include "project_file.hpp"
+
+// Qt include.
+#include <QFile>
+#include <QSet>
+#include <QThreadPool>
+
+// C++ include.
+#include <atomic>
+#include <functional>
+#include <vector>
+
+namespace Prototyper
+{
+
+namespace Core
+{
+
+//
+// ProjectLoadJob
+//
+
+//! State of one reading shared with the worker.
+struct ProjectLoadJob {
+    explicit ProjectLoadJob(const QString &fileName)
+        : m_fileName(fileName)
+        , m_canceled(false)
+    {
+    }
+
+    //! File name.
+    const QString m_fileName;
+    //! Is reading canceled?
+    std::atomic_bool m_canceled;
+}; // struct ProjectLoadJob
+
+//
+// ProgressDevice
+//
+
+//! Reads the source device reporting progress, fails once the job is canceled.
+class ProgressDevice final : public QIODevice
+{
+public:
+    ProgressDevice(QIODevice &source,
+                   ProjectLoadJob &job,
+                   const std::function<void(qint64, qint64)> &progress)
+        : m_source(source)
+        , m_job(job)
+        , m_progress(progress)
+    {
+    }
+
+    qint64 size() const override
+    {
+        return m_source.size();
+    }
+
+    bool seek(qint64 pos) override
+    {
+        return (QIODevice::seek(pos) && m_source.seek(pos));
+    }
+
+protected:
+    qint64 readData(char *data,
+                    qint64 maxSize) override
+    {
+        if (m_job.m_canceled) {
+            setErrorString(QObject::tr("Reading canceled."));
+
+            return -1;
+        }
+
+        const qint64 bytes = m_source.read(data, maxSize);
+
+        if (bytes > 0) {
+            m_progress(m_source.pos(), m_source.size());
+        }
+
+        return bytes;
+    }
+
+    qint64 writeData(const char *,
+                     qint64) override
+    {
+        return -1;
+    }
+
+private:
+    //! Source.
+    QIODevice &m_source;
+    //! Job.
+    ProjectLoadJob &m_job;
+    //! Progress callback.
+    std::function<void(qint64, qint64)> m_progress;
+}; // class ProgressDevice
+
+//! Decode unique images on all cores.
+//! \return Decoded images keyed by SHA-256.
+static QHash<QString, QImage> decodeImages(const std::vector<Cfg::ImageData> &images,
+                                          const ProjectLoadJob &job)
+{
+    std::vector<const Cfg::ImageData *> unique;
+    unique.reserve(images.size());
+
+    QSet<QString> seen;
+
+    for (const auto &data : images) {
+        if (!seen.contains(data.sha256())) {
+            seen.insert(data.sha256());
+            unique.push_back(&data);
+        }
+    }
+
+    // Every task writes its own slot, no locking needed.
+    std::vector<QImage> decoded(unique.size());
+
+    QThreadPool pool;
+
+    for (std::size_t i = 0; i < unique.size(); ++i) {
+        pool.start([&unique, &decoded, &job, i]() {
+            if (!job.m_canceled) {
+                decoded[i] = ImageStore::decode(*unique[i]);
+            }
+        });
+    }
+
+    pool.waitForDone();
+
+    QHash<QString, QImage> res;
+    res.reserve(int(unique.size()));
+
+    for (std::size_t i = 0; i < unique.size(); ++i) {
+        if (!decoded[i].isNull()) {
+            res.insert(unique[i]->sha256(), decoded[i]);
+        }
+    }
+
+    return res;
+}
+
+//
+// ProjectLoaderPrivate
+//
+
+class ProjectLoaderPrivate
+{
+public:
+    explicit ProjectLoaderPrivate(ProjectLoader *parent)
+        : q(parent)
+        , m_isRunning(false)
+        , m_hasPending(false)
+    {
+    }
+
+    //! Init.
+    void init();
+    //! Start reading on the worker thread.
+    void start(const QString &fileName);
+    //! Read project, runs on the worker thread.
+    void read(const std::shared_ptr<ProjectLoadJob> &job);
+    //! Report read bytes, runs on the worker thread.
+    void reportProgress(const std::shared_ptr<ProjectLoadJob> &job,
+                        qint64 done,
+                        qint64 total);
+    //! Reading finished.
+    void finished(const std::shared_ptr<ProjectLoadJob> &job,
+                  const Cfg::Project &cfg,
+                  const QHash<QString, QImage> &images,
+                  const ProjectBundle &bundle,
+                  const QString &error);
+
+    //! Parent.
+    ProjectLoader *q;
+    //! Worker.
+    QThreadPool m_pool;
+    //! Current job.
+    std::shared_ptr<ProjectLoadJob> m_job;
+    //! Is reading in progress?
+    bool m_isRunning;
+    //! Is there a waiting file?
+    bool m_hasPending;
+    //! File to read after the current one is canceled.
+    QString m_pendingFileName;
+}; // class ProjectLoaderPrivate
+
+void ProjectLoaderPrivate::init()
+{
+    m_pool.setMaxThreadCount(1);
+}
+
+void ProjectLoaderPrivate::start(const QString &fileName)
+{
+    m_isRunning = true;
+
+    auto job = std::make_shared<ProjectLoadJob>(fileName);
+
+    m_job = job;
+
+    m_pool.start([this, job]() {
+        read(job);
+    });
+}
+
+void ProjectLoaderPrivate::read(const std::shared_ptr<ProjectLoadJob> &job)
+{
+    Cfg::Project cfg;
+    QHash<QString, QImage> images;
+    ProjectBundle bundle;
+    QString error;
+
+    QFile file(job->m_fileName);
+
+    if (isProjectBundle(job->m_fileName)) {
+        // Pages and images are read on demand.
+        try {
+            cfg = readBundleManifest(job->m_fileName, bundle);
+        } catch (const ProjectFileException &x) {
+            error = x.what();
+        }
+    } else if (file.open(QIODevice::ReadOnly)) {
+        int percent = -1;
+
+        ProgressDevice device(file, *job, [this, job, &percent](qint64 done, qint64 total) {
+            const int p = (total > 0 ? int(done * 100 / total) : 100);
+
+            if (p != percent) {
+                percent = p;
+
+                reportProgress(job, done, total);
+            }
+        });
+
+        // Unbuffered, so peeking the format seeks the file back.
+        device.open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+
+        try {
+            cfg = readProjectFile(device, job->m_fileName);
+        } catch (const ProjectFileException &x) {
+            error = x.what();
+        }
+    } else {
+        error = ProjectLoader::tr("Unable to open file.");
+    }
+
+    // Pages only pick up ready images.
+    if (error.isEmpty() && !job->m_canceled) {
+        images = decodeImages(cfg.images(), *job);
+    }
+
+    QMetaObject::invokeMethod(
+        q,
+        [this, job, cfg, images, bundle, error]() {
+            finished(job, cfg, images, bundle, error);
+        },
+        Qt::QueuedConnection);
+}
+
+void ProjectLoaderPrivate::reportProgress(const std::shared_ptr<ProjectLoadJob> &job,
+                                          qint64 done,
+                                          qint64 total)
+{
+    QMetaObject::invokeMethod(
+        q,
+        [this, job, done, total]() {
+            if (job == m_job && !job->m_canceled) {
+                emit q->progress(done, total);
+            }
+        },
+        Qt::QueuedConnection);
+}
+
+void ProjectLoaderPrivate::finished(const std::shared_ptr<ProjectLoadJob> &job,
+                                    const Cfg::Project &cfg,
+                                    const QHash<QString, QImage> &images,
+                                    const ProjectBundle &bundle,
+                                    const QString &error)
+{
+    m_isRunning = false;
+
+    m_job.reset();
+
+    // Start the waiting file first, so isBusy() is right in handlers.
+    if (m_hasPending) {
+        m_hasPending = false;
+
+        start(m_pendingFileName);
+
+        m_pendingFileName.clear();
+    }
+
+    if (job->m_canceled) {
+        emit q->canceled(job->m_fileName);
+    } else if (!error.isEmpty()) {
+        emit q->failed(job->m_fileName, error);
+    } else {
+        emit q->loaded(job->m_fileName, cfg, images, bundle);
+    }
+}
+
+//
+// ProjectLoader
+//
+
+ProjectLoader::ProjectLoader(QObject *parent)
+    : QObject(parent)
+    , d(new ProjectLoaderPrivate(this))
+{
+    d->init();
+}
+
+ProjectLoader::~ProjectLoader()
+{
+    cancel();
+
+    d->m_pool.waitForDone();
+}
+
+void ProjectLoader::load(const QString &fileName)
+{
+    if (d->m_isRunning) {
+        d->m_job->m_canceled = true;
+        d->m_hasPending = true;
+        d->m_pendingFileName = fileName;
+    } else {
+        d->start(fileName);
+    }
+}
+
+void ProjectLoader::cancel()
+{
+    d->m_hasPending = false;
+    d->m_pendingFileName.clear();
+
+    if (d->m_job) {
+        d->m_job->m_canceled = true;
+    }
+}
+
+bool ProjectLoader::isBusy() const
+{
+    return d->m_isRunning;
+}
+
+} /* namespace Core */
+
+} /* namespace Prototyper */
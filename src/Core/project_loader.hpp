@@ -0,0 +1,81 @@
+
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#ifndef PROTOTYPER__CORE__PROJECT_LOADER_HPP__INCLUDED
+#define PROTOTYPER__CORE__PROJECT_LOADER_HPP__INCLUDED
+
+// Qt include.
+#include <QHash>
+#include <QImage>
+#include <QObject>
+
+// C++ include.
+#include <memory>
+
+// Prototyper include.
+#include "project_bundle.hpp"
+#include "project_cfg.hpp"
+
+namespace Prototyper
+{
+
+namespace Core
+{
+
+//
+// ProjectLoader
+//
+
+class ProjectLoaderPrivate;
+
+//! Reads project on a worker thread.
+class ProjectLoader final : public QObject
+{
+    Q_OBJECT
+
+signals:
+    //! Bytes of the file were read.
+    void progress(qint64 done,
+                  qint64 total);
+    //! Project has been read.
+    //! \param images Decoded images keyed by SHA-256.
+    //! \param bundle Files of the project bundle, only its manifest is read.
+    void loaded(const QString &fileName,
+                const Prototyper::Core::Cfg::Project &cfg,
+                const QHash<QString, QImage> &images,
+                const Prototyper::Core::ProjectBundle &bundle);
+    //! Unable to read project.
+    void failed(const QString &fileName,
+                const QString &error);
+    //! Reading was canceled.
+    void canceled(const QString &fileName);
+
+public:
+    explicit ProjectLoader(QObject *parent = nullptr);
+    ~ProjectLoader() override;
+
+    //! Read project. Reading in progress is canceled.
+    void load(const QString &fileName);
+
+    //! Cancel reading.
+    void cancel();
+
+    //! \return Is reading in progress?
+    bool isBusy() const;
+
+private:
+    friend class ProjectLoaderPrivate;
+
+    Q_DISABLE_COPY(ProjectLoader)
+
+    std::unique_ptr<ProjectLoaderPrivate> d;
+}; // class ProjectLoader
+
+} /* namespace Core */
+
+} /* namespace Prototyper */
+
+#endif // PROTOTYPER__CORE__PROJECT_LOADER_HPP__INCLUDED
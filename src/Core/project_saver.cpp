@@ -0,0 +1,258 @@
+
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+// Prototyper include.
+#include "project_saver.hpp"
+#include "project_bundle.hpp"
+#include "project_cfg.hpp"
+#include "project_file.hpp"
+#include "project_index.hpp"
+
+// Qt include.
+#include <QCoreApplication>
+#include <QEvent>
+#include <QList>
+#include <QSaveFile>
+#include <QStringList>
+#include <QThreadPool>
+
+// C++ include.
+#include <utility>
+
+namespace Prototyper
+{
+
+namespace Core
+{
+
+//
+// ProjectSnapshot
+//
+
+//! Snapshot of the project to write.
+struct ProjectSnapshot {
+    //! Project.
+    Cfg::Project m_cfg;
+    //! Serialized pages, written instead of pages of m_cfg if m_isSerialized.
+    QStringList m_pages;
+    //! Are pages serialized?
+    bool m_isSerialized = false;
+    //! Index.
+    ProjectIndex m_index;
+    //! Changes of the bundle, written instead of m_cfg if m_isBundle.
+    ProjectBundleChanges m_bundle;
+    //! Is it a bundle?
+    bool m_isBundle = false;
+    //! File name.
+    QString m_fileName;
+}; // struct ProjectSnapshot
+
+//
+// ProjectSaverPrivate
+//
+
+class ProjectSaverPrivate
+{
+public:
+    explicit ProjectSaverPrivate(ProjectSaver *parent)
+        : q(parent)
+        , m_isRunning(false)
+    {
+    }
+
+    //! Init.
+    void init();
+    //! Write snapshot now or after the current save.
+    void save(ProjectSnapshot &&snapshot);
+    //! Start writing on the worker thread.
+    void start(const ProjectSnapshot &snapshot);
+    //! Writing finished.
+    void finished(const QString &fileName,
+                  const QString &error);
+    //! Write project into the temporary file and rename it into place.
+    //! \return Error description or empty string.
+    static QString write(const ProjectSnapshot &snapshot);
+
+    //! Parent.
+    ProjectSaver *q;
+    //! Worker.
+    QThreadPool m_pool;
+    //! Is writing in progress?
+    bool m_isRunning;
+    //! Waiting snapshots, one per file.
+    QList<ProjectSnapshot> m_pending;
+}; // class ProjectSaverPrivate
+
+void ProjectSaverPrivate::init()
+{
+    m_pool.setMaxThreadCount(1);
+}
+
+void ProjectSaverPrivate::save(ProjectSnapshot &&snapshot)
+{
+    if (m_isRunning) {
+        // Newer snapshot of the same file holds all changes of the waiting one.
+        for (auto &pending : m_pending) {
+            if (pending.m_fileName == snapshot.m_fileName) {
+                pending = std::move(snapshot);
+
+                return;
+            }
+        }
+
+        m_pending.append(std::move(snapshot));
+    } else {
+        start(snapshot);
+    }
+}
+
+void ProjectSaverPrivate::start(const ProjectSnapshot &snapshot)
+{
+    m_isRunning = true;
+
+    m_pool.start([this, snapshot]() {
+        const QString error = write(snapshot);
+
+        QMetaObject::invokeMethod(
+            q,
+            [this, fileName = snapshot.m_fileName, error]() {
+                finished(fileName, error);
+            },
+            Qt::QueuedConnection);
+    });
+}
+
+void ProjectSaverPrivate::finished(const QString &fileName,
+                                   const QString &error)
+{
+    m_isRunning = false;
+
+    // Start the waiting snapshot first, slots see that saving goes on.
+    if (!m_pending.isEmpty()) {
+        start(m_pending.takeFirst());
+    }
+
+    if (error.isEmpty()) {
+        emit q->saved(fileName);
+    } else {
+        emit q->failed(fileName, error);
+    }
+}
+
+QString ProjectSaverPrivate::write(const ProjectSnapshot &snapshot)
+{
+    // Files of the bundle are replaced one by one.
+    if (snapshot.m_isBundle) {
+        try {
+            writeBundle(snapshot.m_fileName, snapshot.m_bundle);
+        } catch (const ProjectFileException &x) {
+            return x.what();
+        }
+
+        return QString();
+    }
+
+    QSaveFile file(snapshot.m_fileName);
+
+    if (!file.open(QIODevice::WriteOnly)) {
+        return ProjectSaver::tr("Unable to open file.");
+    }
+
+    try {
+        if (snapshot.m_isSerialized) {
+            writeTextProject(snapshot.m_cfg,
+                             snapshot.m_pages,
+                             file,
+                             projectFormatForFileName(snapshot.m_fileName),
+                             &snapshot.m_index);
+        } else {
+            writeProjectFile(snapshot.m_cfg, file, projectFormatForFileName(snapshot.m_fileName), &snapshot.m_index);
+        }
+    } catch (const ProjectFileException &x) {
+        file.cancelWriting();
+
+        return x.what();
+    }
+
+    if (!file.commit()) {
+        return file.errorString();
+    }
+
+    return QString();
+}
+
+//
+// ProjectSaver
+//
+
+ProjectSaver::ProjectSaver(QObject *parent)
+    : QObject(parent)
+    , d(new ProjectSaverPrivate(this))
+{
+    d->init();
+}
+
+ProjectSaver::~ProjectSaver()
+{
+    d->m_pool.waitForDone();
+}
+
+void ProjectSaver::save(const Cfg::Project &cfg,
+                        const ProjectIndex &index,
+                        const QString &fileName)
+{
+    ProjectSnapshot snapshot;
+    snapshot.m_cfg = cfg;
+    snapshot.m_index = index;
+    snapshot.m_fileName = fileName;
+
+    d->save(std::move(snapshot));
+}
+
+void ProjectSaver::save(const Cfg::Project &cfg,
+                        const QStringList &pages,
+                        const ProjectIndex &index,
+                        const QString &fileName)
+{
+    ProjectSnapshot snapshot;
+    snapshot.m_cfg = cfg;
+    snapshot.m_pages = pages;
+    snapshot.m_index = index;
+    snapshot.m_isSerialized = true;
+    snapshot.m_fileName = fileName;
+
+    d->save(std::move(snapshot));
+}
+
+void ProjectSaver::save(const ProjectBundleChanges &changes,
+                        const QString &dir)
+{
+    ProjectSnapshot snapshot;
+    snapshot.m_bundle = changes;
+    snapshot.m_isBundle = true;
+    snapshot.m_fileName = dir;
+
+    d->save(std::move(snapshot));
+}
+
+bool ProjectSaver::isBusy() const
+{
+    return d->m_isRunning;
+}
+
+void ProjectSaver::waitForDone()
+{
+    while (d->m_isRunning) {
+        d->m_pool.waitForDone();
+
+        // Deliver the queued completion, it may start the waiting save.
+        QCoreApplication::sendPostedEvents(this, QEvent::MetaCall);
+    }
+}
+
+} /* namespace Core */
+
+} /* namespace Prototyper */
@@ -0,0 +1,90 @@
+
+/*
+    SPDX-FileCopyrightText: 2026 Igor Mironchik <igor.mironchik@gmail.com>
+    SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#ifndef PROTOTYPER__CORE__PROJECT_SAVER_HPP__INCLUDED
+#define PROTOTYPER__CORE__PROJECT_SAVER_HPP__INCLUDED
+
+// Qt include.
+#include <QObject>
+#include <QStringList>
+
+// C++ include.
+#include <memory>
+
+namespace Prototyper
+{
+
+namespace Core
+{
+
+namespace Cfg
+{
+
+class Project;
+
+} /* namespace Cfg */
+
+struct ProjectBundleChanges;
+struct ProjectIndex;
+
+//
+// ProjectSaver
+//
+
+class ProjectSaverPrivate;
+
+//! Writes snapshots of the project on a worker thread.
+class ProjectSaver final : public QObject
+{
+    Q_OBJECT
+
+signals:
+    //! Project has been saved.
+    void saved(const QString &fileName);
+    //! Unable to save project.
+    void failed(const QString &fileName,
+                const QString &error);
+
+public:
+    explicit ProjectSaver(QObject *parent = nullptr);
+    ~ProjectSaver() override;
+
+    //! Save snapshot of the project. If saving is in progress the snapshot
+    //! replaces the waiting one of the same file or waits after the others,
+    //! snapshots are written in turn.
+    //! \a index goes to the head of the file.
+    void save(const Cfg::Project &cfg,
+              const ProjectIndex &index,
+              const QString &fileName);
+    //! Save snapshot of the project in text format. Pages are given
+    //! already serialized, pages of \a cfg are ignored.
+    void save(const Cfg::Project &cfg,
+              const QStringList &pages,
+              const ProjectIndex &index,
+              const QString &fileName);
+    //! Save changes of the project bundle into the bundle directory.
+    void save(const ProjectBundleChanges &changes,
+              const QString &dir);
+
+    //! \return Is saving in progress?
+    bool isBusy() const;
+
+    //! Block till all requested saves are done.
+    void waitForDone();
+
+private:
+    friend class ProjectSaverPrivate;
+
+    Q_DISABLE_COPY(ProjectSaver)
+
+    std::unique_ptr<ProjectSaverPrivate> d;
+}; // class ProjectSaver
+
+} /* namespace Core */
+
+} /* namespace Prototyper */
+
+#endif // PROTOTYPER__CORE__PROJECT_SAVER_HPP__INCLUDED
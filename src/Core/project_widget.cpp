@@ -8,6 +8,7 @@
 #include "project_widget.hpp"
 #include "constants.hpp"
 #include "dlg/name_dlg.hpp"
+#include "form/image_store.hpp"
 #include "form/page.hpp"
 #include "form/page_scene.hpp"
 #include "form/page_view.hpp"
@@ -22,14 +23,18 @@
 
 // Qt include.
 #include <QAction>
-#include <QApplication>
+#include <QFileInfo>
 #include <QMessageBox>
 #include <QStringListModel>
 #include <QTabWidget>
+#include <QTimer>
 #include <QUndoGroup>
 #include <QUndoStack>
 #include <QVBoxLayout>
 
+// C++ include.
+#include <algorithm>
+
 namespace Prototyper
 {
 
@@ -73,6 +78,9 @@ public:
         , m_tabBar(nullptr)
         , m_undoGroup(nullptr)
         , m_isTabRenamed(false)
+        , m_memoryBudget(qint64(c_defaultPagesMemoryBudget) * 1024 * 1024)
+        , m_loadTimer(nullptr)
+        , m_pendingPage(0)
     {
     }
 
@@ -81,8 +89,19 @@ public:
     //! New project.
     void newProject();
     //! Add page.
-    void addPage(const Cfg::Page &cfg,
-                 bool showGrid);
+    void addPage(const Cfg::Page &cfg);
+    //! Add next pages of the opened project.
+    void addPendingPages(std::size_t count);
+    //! Page's scene was built.
+    void pageMaterialized(PageView *form);
+    //! Mark page as most recently used.
+    void touch(PageView *form);
+    //! Destroy scenes of least recently used pages while over the budget.
+    void evict();
+    //! \return Can page's scene be destroyed?
+    bool isEvictable(PageView *form) const;
+    //! Destroy page's scene.
+    void dematerialize(PageView *form);
 
     //! Parent.
     ProjectWidget *q;
@@ -90,8 +109,8 @@ public:
     ProjectWindow *m_window;
     //! Cfg.
     Cfg::Project &m_cfg;
-    //! Hash of images.
-    ImagesHash m_imagesHash;
+    //! Images of the project.
+    ImageStore m_imageStore;
     //! Tabs.
     TabWidget *m_tabs;
     //! Desc tab.
@@ -106,6 +125,16 @@ public:
     QUndoGroup *m_undoGroup;
     //! Is tab renamed?
     bool m_isTabRenamed;
+    //! Pages with built scenes, least recently used first.
+    QList<PageView *> m_lru;
+    //! Memory budget for pages' scenes.
+    qint64 m_memoryBudget;
+    //! Adds pages of the opened project from the event loop.
+    QTimer *m_loadTimer;
+    //! Index of the next page of the opened project to add.
+    std::size_t m_pendingPage;
+    //! Files of the opened project bundle.
+    ProjectBundle m_bundle;
 }; // class ProjectWidgetPrivate
 
 void ProjectWidgetPrivate::init()
@@ -128,11 +157,17 @@ void ProjectWidgetPrivate::init()
 
     m_undoGroup = new QUndoGroup(q);
 
+    m_loadTimer = new QTimer(q);
+    m_loadTimer->setInterval(0);
+
     ProjectWidget::connect(m_tabBar, &ProjectTabBar::formRenameRequest, q, &ProjectWidget::renameTab);
     ProjectWidget::connect(m_tabBar, &ProjectTabBar::formAddRequest, q, &ProjectWidget::addPage);
     ProjectWidget::connect(m_tabBar, &ProjectTabBar::formDeleteRequest, q, &ProjectWidget::deletePage);
     ProjectWidget::connect(m_desc->editor(), &TextEditor::changed, q, &ProjectWidget::changed);
     ProjectWidget::connect(m_tabs, &QTabWidget::currentChanged, q, &ProjectWidget::tabChanged);
+    ProjectWidget::connect(m_loadTimer, &QTimer::timeout, q, [this]() {
+        addPendingPages(c_pagesPerLoadingStep);
+    });
 }
 
 void ProjectWidgetPrivate::newProject()
@@ -146,15 +181,29 @@ void ProjectWidgetPrivate::newProject()
 
         ProjectWidget::disconnect(tab, nullptr, nullptr, nullptr);
 
-        m_undoGroup->removeStack(m_forms.at(i - 1)->page()->undoStack());
+        if (m_forms.at(i - 1)->isMaterialized()) {
+            m_undoGroup->removeStack(m_forms.at(i - 1)->page()->undoStack());
 
-        m_forms.at(i - 1)->page()->undoStack()->deleteLater();
+            m_forms.at(i - 1)->page()->undoStack()->deleteLater();
+        }
 
         tab->deleteLater();
     }
 
     m_forms.clear();
 
+    m_lru.clear();
+
+    m_loadTimer->stop();
+
+    m_pendingPage = 0;
+
+    m_bundle = ProjectBundle();
+
+    m_imageStore.clear();
+
+    emit q->residentPagesChanged();
+
     static const QString projectDescTabName = ProjectWidget::tr("Description");
 
     m_tabs->setTabText(0, projectDescTabName);
@@ -172,15 +221,15 @@ void ProjectWidgetPrivate::newProject()
     q->cleanUndoGroup();
 }
 
-void ProjectWidgetPrivate::addPage(const Cfg::Page &cfg,
-                                   bool showGrid)
+void ProjectWidgetPrivate::addPage(const Cfg::Page &cfg)
 {
-    auto *form = new PageView(cfg, m_imagesHash, m_tabs);
+    // Scene of the page is built on first activation of the tab.
+    auto *form = new PageView(cfg, m_imageStore, m_tabs);
 
     ProjectWidget::connect(form, &PageView::zoomChanged, m_window, &ProjectWindow::zoomChanged);
-    ProjectWidget::connect(form->pageScene(), &PageScene::selectionChanged, m_window, &ProjectWindow::selectionChanged);
-
-    form->page()->setGridMode(showGrid ? ShowGrid : NoGrid);
+    ProjectWidget::connect(form, &PageView::materialized, q, [this, form]() {
+        pageMaterialized(form);
+    });
 
     m_tabNames.append(cfg.tabName());
 
@@ -188,10 +237,113 @@ void ProjectWidgetPrivate::addPage(const Cfg::Page &cfg,
 
     m_forms.append(form);
 
+    emit q->residentPagesChanged();
+}
+
+void ProjectWidgetPrivate::addPendingPages(std::size_t count)
+{
+    const std::size_t total = m_cfg.page().size();
+    const std::size_t last = std::min(m_pendingPage + count, total);
+
+    for (; m_pendingPage < last; ++m_pendingPage) {
+        const Cfg::Page &cfg = m_cfg.page()[m_pendingPage];
+
+        addPage(cfg);
+
+        const QString file = m_bundle.m_pages.value(cfg.tabName());
+
+        if (!file.isEmpty()) {
+            m_forms.constLast()->loadOnDemand(file);
+        }
+    }
+
+    TopGui::instance()->projectWindow()->tabsList()->model()->setStringList(m_tabNames);
+
+    if (m_pendingPage == total) {
+        m_loadTimer->stop();
+    }
+
+    emit q->pagesLoadingProgress(int(m_pendingPage), int(total));
+}
+
+void ProjectWidgetPrivate::pageMaterialized(PageView *form)
+{
+    ProjectWidget::connect(form->pageScene(), &PageScene::selectionChanged, m_window, &ProjectWindow::selectionChanged);
+
+    form->page()->setGridMode(m_cfg.showGrid() ? ShowGrid : NoGrid);
+
     ProjectWidget::connect(form->pageScene(), &PageScene::changed, q, &ProjectWidget::changed);
     ProjectWidget::connect(form->page(), &Page::changed, q, &ProjectWidget::changed);
 
-    emit q->pageAdded(form);
+    emit q->pageMaterialized(form);
+
+    touch(form);
+
+    if (!form->loadError().isEmpty()) {
+        QMessageBox::warning(q,
+                             ProjectWidget::tr("Unable to Read Page..."),
+                             ProjectWidget::tr("Unable to read page \"%1\", it's shown empty and can't be saved.\n%2")
+                                 .arg(form->pageFile(), form->loadError()));
+    }
+}
+
+void ProjectWidgetPrivate::touch(PageView *form)
+{
+    m_lru.removeOne(form);
+    m_lru.append(form);
+
+    evict();
+
+    emit q->residentPagesChanged();
+}
+
+void ProjectWidgetPrivate::evict()
+{
+    qint64 used = 0;
+
+    for (const auto &form : std::as_const(m_lru)) {
+        used += form->memoryUsage();
+    }
+
+    const bool isOverBudget = (used > m_memoryBudget);
+
+    // The most recently used page is never evicted.
+    for (int i = 0; i < m_lru.size() - 1 && used > m_memoryBudget;) {
+        PageView *form = m_lru.at(i);
+
+        if (isEvictable(form)) {
+            used -= form->memoryUsage();
+
+            m_lru.removeAt(i);
+
+            dematerialize(form);
+        } else {
+            ++i;
+        }
+    }
+
+    // Images decoded while loading are kept for pages opened later
+    // unless memory is short.
+    if (isOverBudget) {
+        m_imageStore.releaseUnpinned();
+    }
+}
+
+bool ProjectWidgetPrivate::isEvictable(PageView *form) const
+{
+    return (form != m_tabs->currentWidget() && form->page()->undoStack()->isClean()
+            && !form->page()->isCommentChanged());
+}
+
+void ProjectWidgetPrivate::dematerialize(PageView *form)
+{
+    QUndoStack *stack = form->page()->undoStack();
+
+    m_undoGroup->removeStack(stack);
+
+    form->dematerialize();
+
+    stack->deleteLater();
 }
 
 //
@@ -217,6 +369,11 @@ const QList<PageView *> &ProjectWidget::pages() const
     return d->m_forms;
 }
 
+ImageStore &ProjectWidget::imageStore() const
+{
+    return d->m_imageStore;
+}
+
 void ProjectWidget::enableSelection(bool on)
 {
     foreach (PageView *view, d->m_forms)
@@ -246,18 +403,20 @@ ProjectDescTab *ProjectWidget::descriptionTab() const
     return d->m_desc;
 }
 
-void ProjectWidget::setProject(const Cfg::Project &cfg)
+void ProjectWidget::setProject(const Cfg::Project &cfg,
+                               const QHash<QString, QImage> &images,
+                               const ProjectBundle &bundle)
 {
     d->newProject();
 
-    QApplication::processEvents();
-
     d->m_cfg = cfg;
 
-    d->m_imagesHash.clear();
+    d->m_bundle = bundle;
 
-    for (const auto &image : std::as_const(d->m_cfg.images())) {
-        d->m_imagesHash.insert(image.sha256(), image);
+    d->m_imageStore.setImages(d->m_cfg.images(), images);
+
+    for (auto it = bundle.m_images.cbegin(), last = bundle.m_images.cend(); it != last; ++it) {
+        d->m_imageStore.addFile(it.key(), QFileInfo(it.value()).suffix().toUpper(), it.value());
     }
 
     d->m_desc->editor()->setText(d->m_cfg.description().text());
@@ -266,18 +425,28 @@ void ProjectWidget::setProject(const Cfg::Project &cfg)
 
     d->m_tabNames[0] = d->m_cfg.description().tabName();
 
-    auto it = d->m_cfg.page().cbegin();
-    auto last = d->m_cfg.page().cend();
+    // The first page is shown at once, the rest streams in.
+    d->addPendingPages(1);
 
-    for (; it != last; ++it) {
-        d->addPage(*it, d->m_cfg.showGrid());
+    if (isLoading()) {
+        d->m_loadTimer->start();
     }
 
-    TopGui::instance()->projectWindow()->tabsList()->model()->setStringList(d->m_tabNames);
-
     cleanUndoGroup();
 }
 
+bool ProjectWidget::isLoading() const
+{
+    return (d->m_pendingPage < d->m_cfg.page().size());
+}
+
+void ProjectWidget::finishLoading()
+{
+    if (isLoading()) {
+        d->addPendingPages(d->m_cfg.page().size());
+    }
+}
+
 QUndoGroup *ProjectWidget::undoGroup() const
 {
     return d->m_undoGroup;
@@ -295,9 +464,17 @@ void ProjectWidget::addPage()
     cfg.set_gridStep(d->m_cfg.defaultGridStep());
     cfg.size().set_width(c_a4Width);
     cfg.size().set_height(c_a4Height);
+    // New page goes after all pages of the opened project.
+    finishLoading();
+
     cfg.set_tabName(tr("Page %1").arg(QString::number(d->m_tabs->count())));
 
-    d->addPage(cfg, d->m_cfg.showGrid());
+    d->addPage(cfg);
+
+    // New page differs from the saved project.
+    d->m_forms.constLast()->invalidateSerialized();
+
+    emit pageAdded(d->m_forms.constLast());
 
     d->m_tabs->setCurrentIndex(d->m_tabs->count() - 1);
 
@@ -313,8 +490,11 @@ void ProjectWidget::renameTab(const QString &oldName)
 
         QStringList names = d->m_tabNames;
 
-        if (index - 1 >= 0)
+        if (index - 1 >= 0) {
+            d->m_forms.at(index - 1)->materialize();
+
             names << d->m_forms.at(index - 1)->page()->ids();
+        }
 
         NameDlg dlg(names,
                     (index == 0 ? tr("Enter New Project Tab Name...") : tr("Enter New Page Name...")),
@@ -328,6 +508,7 @@ void ProjectWidget::renameTab(const QString &oldName)
 
             if (index > 0) {
                 d->m_forms[index - 1]->page()->renameForm(dlg.name());
+                d->m_forms[index - 1]->invalidateSerialized();
             } else {
                 d->m_cfg.description().set_tabName(dlg.name());
             }
@@ -353,9 +534,11 @@ void ProjectWidget::deletePage(const QString &name)
         if (btn == QMessageBox::Yes) {
             const int index = d->m_tabNames.indexOf(name);
 
-            d->m_undoGroup->removeStack(d->m_forms.at(index - 1)->page()->undoStack());
+            if (d->m_forms.at(index - 1)->isMaterialized()) {
+                d->m_undoGroup->removeStack(d->m_forms.at(index - 1)->page()->undoStack());
 
-            d->m_forms.at(index - 1)->page()->undoStack()->deleteLater();
+                d->m_forms.at(index - 1)->page()->undoStack()->deleteLater();
+            }
 
             QWidget *tab = d->m_tabs->widget(index);
 
@@ -365,6 +548,8 @@ void ProjectWidget::deletePage(const QString &name)
 
             d->m_forms.removeAt(index - 1);
 
+            d->m_lru.removeOne(form);
+
             d->m_tabs->removeTab(index);
 
             disconnect(tab, nullptr, nullptr, nullptr);
@@ -376,6 +561,8 @@ void ProjectWidget::deletePage(const QString &name)
             emit changed();
 
             emit pageDeleted(form);
+
+            emit residentPagesChanged();
         }
     }
 }
@@ -395,6 +582,10 @@ void ProjectWidget::activateTab(const QString &tabName)
 void ProjectWidget::tabChanged(int index)
 {
     if (index > 0) {
+        d->m_forms.at(index - 1)->materialize();
+
+        d->touch(d->m_forms.at(index - 1));
+
         d->m_undoGroup->setActiveStack(d->m_forms.at(index - 1)->page()->undoStack());
     } else {
         d->m_undoGroup->setActiveStack(Q_NULLPTR);
@@ -414,7 +605,7 @@ void ProjectWidget::setTabRenamed(bool on)
 bool ProjectWidget::isCommentChanged() const
 {
     for (const auto &f : std::as_const(d->m_forms)) {
-        if (f->page()->isCommentChanged()) {
+        if (f->isMaterialized() && f->page()->isCommentChanged()) {
             return true;
         }
     }
@@ -422,10 +613,60 @@ bool ProjectWidget::isCommentChanged() const
     return false;
 }
 
+qint64 ProjectWidget::memoryBudget() const
+{
+    return d->m_memoryBudget;
+}
+
+void ProjectWidget::setMemoryBudget(qint64 bytes)
+{
+    d->m_memoryBudget = bytes;
+
+    d->evict();
+
+    emit residentPagesChanged();
+}
+
+int ProjectWidget::residentPagesCount() const
+{
+    return d->m_lru.size();
+}
+
 void ProjectWidget::clearCommentChanged()
 {
     for (const auto &f : std::as_const(d->m_forms)) {
-        f->page()->clearCommentChanged();
+        if (f->isMaterialized()) {
+            f->page()->clearCommentChanged();
+        }
+    }
+}
+
+QList<PageView *> ProjectWidget::commentChangedPages() const
+{
+    QList<PageView *> res;
+
+    for (const auto &f : std::as_const(d->m_forms)) {
+        if (f->isMaterialized() && f->page()->isCommentChanged()) {
+            res.append(f);
+        }
+    }
+
+    return res;
+}
+
+void ProjectWidget::setCommentChanged(const QList<PageView *> &pages)
+{
+    for (const auto &f : pages) {
+        if (!d->m_forms.contains(f)) {
+            continue;
+        }
+
+        // Page evicted since then keeps comments in its configuration.
+        if (f->isMaterialized()) {
+            f->page()->setCommentChanged();
+        }
+
+        f->invalidateSerialized();
     }
 }
 
@@ -8,11 +8,16 @@
 #define PROTOTYPER__CORE__PROJECT_WIDGET_HPP__INCLUDED
 
 // Qt include.
+#include <QHash>
+#include <QImage>
 #include <QWidget>
 
 // C++ include.
 #include <memory>
 
+// Prototyper include.
+#include "project_bundle.hpp"
+
 QT_BEGIN_NAMESPACE
 class QTabWidget;
 class QUndoGroup;
@@ -31,6 +36,7 @@ class Project;
 
 } /* namespace Cfg */
 
+class ImageStore;
 class PageView;
 class ProjectDescTab;
 class ProjectWindow;
@@ -53,6 +59,13 @@ signals:
     void pageAdded(Prototyper::Core::PageView *);
     //! Page deleted.
     void pageDeleted(Prototyper::Core::PageView *);
+    //! Page's scene was built.
+    void pageMaterialized(Prototyper::Core::PageView *);
+    //! Count of pages with built scenes changed.
+    void residentPagesChanged();
+    //! Pages of the opened project were added.
+    void pagesLoadingProgress(int loaded,
+                              int total);
 
 public:
     explicit ProjectWidget(Cfg::Project &cfg,
@@ -63,6 +76,9 @@ public:
     //! \return Pages.
     const QList<PageView *> &pages() const;
 
+    //! \return Images of the project.
+    ImageStore &imageStore() const;
+
     //! Enable/disable selection.
     void enableSelection(bool on = true);
 
@@ -78,8 +94,17 @@ public:
     //! \return Project's description tab.
     ProjectDescTab *descriptionTab() const;
 
-    //! Set project.
-    void setProject(const Cfg::Project &cfg);
+    //! Set project. Pages after the first one are added from the event loop.
+    //! \param images Images decoded in advance, keyed by SHA-256.
+    //! \param bundle Files of the project bundle, pages listed there are
+    //! read on first use.
+    void setProject(const Cfg::Project &cfg,
+                    const QHash<QString, QImage> &images = QHash<QString, QImage>(),
+                    const ProjectBundle &bundle = ProjectBundle());
+    //! \return Are pages of the opened project still being added?
+    bool isLoading() const;
+    //! Add all pages of the opened project that are not added yet.
+    void finishLoading();
 
     //! \return Undo group.
     QUndoGroup *undoGroup() const;
@@ -96,6 +121,17 @@ public:
     bool isCommentChanged() const;
     //! Clear comment changed flag.
     void clearCommentChanged();
+    //! \return Pages with changed comments.
+    QList<PageView *> commentChangedPages() const;
+    //! Mark comments of the given pages changed again.
+    void setCommentChanged(const QList<PageView *> &pages);
+
+    //! \return Memory budget for pages' scenes, in bytes.
+    qint64 memoryBudget() const;
+    //! Set memory budget for pages' scenes, in bytes.
+    void setMemoryBudget(qint64 bytes);
+    //! \return Count of pages with built scenes.
+    int residentPagesCount() const;
 
 public slots:
     //! Add page.
@@ -12,6 +12,8 @@
 #include "exporter/svg_exporter.hpp"
 #include "form/actions.hpp"
 #include "form/group.hpp"
+#include "form/image_store.hpp"
+#include "form/image.hpp"
 #include "form/object.hpp"
 #include "form/page.hpp"
 #include "form/page_scene.hpp"
@@ -19,8 +21,14 @@
 #include "form/text.hpp"
 #include "form/undo_commands.hpp"
 #include "form/utils.hpp"
+#include "project_bundle.hpp"
 #include "project_cfg.hpp"
+#include "project_index.hpp"
 #include "project_description_tab.hpp"
+#include "project_file.hpp"
+#include "project_journal.hpp"
+#include "project_loader.hpp"
+#include "project_saver.hpp"
 #include "project_widget.hpp"
 #include "session_cfg.hpp"
 #include "tabs_list.hpp"
@@ -32,24 +40,36 @@
 #include <QAction>
 #include <QActionGroup>
 #include <QApplication>
+#include <QBuffer>
 #include <QCloseEvent>
 #include <QColorDialog>
 #include <QDrag>
 #include <QFile>
 #include <QFileDialog>
 #include <QImage>
+#include <QImageReader>
+#include <QInputDialog>
+#include <QLabel>
 #include <QMenu>
 #include <QMenuBar>
 #include <QMessageBox>
 #include <QMimeData>
+#include <QProgressBar>
 #include <QScrollArea>
+#include <QSet>
 #include <QStandardPaths>
+#include <QStatusBar>
 #include <QStringListModel>
-#include <QTextStream>
+#include <QTimer>
 #include <QToolBar>
+#include <QToolButton>
 #include <QUndoGroup>
 #include <QUndoStack>
 
+// C++ include.
+#include <utility>
+#include <vector>
+
 namespace Prototyper
 {
 
@@ -109,6 +129,14 @@ public:
         , m_down(nullptr)
         , m_propertiesDock(nullptr)
         , m_propertiesScrollArea(nullptr)
+        , m_residentPages(nullptr)
+        , m_loadProgress(nullptr)
+        , m_cancelLoad(nullptr)
+        , m_saver(nullptr)
+        , m_loader(nullptr)
+        , m_journalTimer(nullptr)
+        , m_savingEveryPageLoaded(false)
+        , m_savingTabRenamed(false)
         , m_isQuit(false)
     {
     }
@@ -131,12 +159,36 @@ public:
                        bool on);
     //! Update cfg.
     void updateCfg();
+    //! Update cfg except pages, pages are cleared.
+    void updateProjectCfg();
+    //! \return Serialized pages.
+    QStringList serializedPages() const;
+    //! \return Index of the project, entries of unchanged pages are reused.
+    ProjectIndex projectIndex() const;
+    //! \return Changes of the project bundle since the last save, files of
+    //! pages in the snapshot are kept in m_savingPageFiles.
+    ProjectBundleChanges bundleChanges();
     //! Prepare to draw with rect placer.
     void prepareForDrawing(bool editable = false);
     //! Clear edit mode in texts.
     void clearEditModeInTexts();
     //! Clean added/deleted pages.
     void cleanPages();
+    //! \return Current revisions of pages.
+    QHash<quint64, quint64> revisions() const;
+    //! \return SHA-256 of used images.
+    QSet<QString> usedImages() const;
+    //! \return Are all pages read? Images of pages not read are unknown.
+    bool isEveryPageLoaded() const;
+    //! Forget state cleared by saves in progress.
+    void clearSavingState();
+    //! Take current state as the saved one.
+    void resetJournal();
+    //! Write changes in the next batch.
+    void scheduleJournal();
+    //! Write changes since the last batch to the journal.
+    //! \param checkpoint Replace the journal with changes since the last save.
+    void writeJournal(bool checkpoint = false);
 
     //! Parent.
     ProjectWindow *q;
@@ -210,6 +262,44 @@ public:
     QDockWidget *m_propertiesDock;
     //! Scroll area for properties.
     QScrollArea *m_propertiesScrollArea;
+    //! Resident pages label.
+    QLabel *m_residentPages;
+    //! Progress of opening the project.
+    QProgressBar *m_loadProgress;
+    //! Cancel opening of the project.
+    QToolButton *m_cancelLoad;
+    //! Saver.
+    ProjectSaver *m_saver;
+    //! Loader.
+    ProjectLoader *m_loader;
+    //! Journal of unsaved changes.
+    ProjectJournal m_journal;
+    //! Batches journal writes.
+    QTimer *m_journalTimer;
+    //! Revisions of pages in the saved file, keyed by identifiers of pages.
+    QHash<quint64, quint64> m_savedRevisions;
+    //! Revisions of pages in the snapshot being saved.
+    QHash<quint64, quint64> m_savingRevisions;
+    //! Revisions of pages written to the journal.
+    QHash<quint64, quint64> m_journaledRevisions;
+    //! Images in the saved file.
+    QSet<QString> m_savedImages;
+    //! Images in the snapshot being saved.
+    QSet<QString> m_savingImages;
+    //! Images in the saved file or in the journal.
+    QSet<QString> m_journaledImages;
+    //! Page files in the bundle snapshot being saved.
+    QHash<PageView *, QString> m_savingPageFiles;
+    //! Were all pages read when the snapshot was taken?
+    bool m_savingEveryPageLoaded;
+    //! Added forms cleared by saves in progress.
+    QList<PageView *> m_savingAddedForms;
+    //! Deleted forms cleared by saves in progress.
+    QList<PageView *> m_savingDeletedForms;
+    //! Pages with comments changed cleared by saves in progress.
+    QList<PageView *> m_savingCommentChanged;
+    //! Was tab renamed before saves in progress?
+    bool m_savingTabRenamed;
     //! Added forms.
     QList<PageView *> m_addedForms;
     //! Deleted forms.
@@ -230,6 +320,26 @@ void ProjectWindowPrivate::init()
 
     q->setWindowTitle(ProjectWindow::tr("Prototyper - Unsaved[*]"));
 
+    m_residentPages = new QLabel(q);
+    q->statusBar()->addPermanentWidget(m_residentPages);
+
+    m_loadProgress = new QProgressBar(q);
+    m_loadProgress->hide();
+    q->statusBar()->addPermanentWidget(m_loadProgress);
+
+    m_cancelLoad = new QToolButton(q);
+    m_cancelLoad->setText(ProjectWindow::tr("Cancel"));
+    m_cancelLoad->hide();
+    q->statusBar()->addPermanentWidget(m_cancelLoad);
+
+    m_saver = new ProjectSaver(q);
+
+    m_loader = new ProjectLoader(q);
+
+    m_journalTimer = new QTimer(q);
+    m_journalTimer->setSingleShot(true);
+    m_journalTimer->setInterval(c_journalInterval);
+
     QMenu *file = q->menuBar()->addMenu(ProjectWindow::tr("&File"));
 
     QAction *newProject =
@@ -252,6 +362,8 @@ void ProjectWindowPrivate::init()
     QAction *saveProjectAs =
         file->addAction(QIcon(QStringLiteral(":/Core/img/document-save-as.png")), ProjectWindow::tr("Save Project As"));
 
+    QAction *precision = file->addAction(ProjectWindow::tr("Save Precision"));
+
     file->addSeparator();
 
     QMenu *exportMenu =
@@ -610,6 +722,7 @@ void ProjectWindowPrivate::init()
     ProjectWindow::connect(openProject, &QAction::triggered, q, &ProjectWindow::openProject);
     ProjectWindow::connect(m_saveProject, &QAction::triggered, q, &ProjectWindow::saveProject);
     ProjectWindow::connect(saveProjectAs, &QAction::triggered, q, &ProjectWindow::saveProjectAs);
+    ProjectWindow::connect(precision, &QAction::triggered, q, &ProjectWindow::setPrecision);
     ProjectWindow::connect(m_widget, &ProjectWidget::changed, q, &ProjectWindow::projectChanged);
     ProjectWindow::connect(m_select, &QAction::toggled, q, &ProjectWindow::select);
     ProjectWindow::connect(m_drawLine, &QAction::triggered, q, &ProjectWindow::drawLine);
@@ -645,12 +758,34 @@ void ProjectWindowPrivate::init()
     ProjectWindow::connect(m_zoomOut, &QAction::triggered, q, &ProjectWindow::zoomOut);
     ProjectWindow::connect(m_duplicate, &QAction::triggered, q, &ProjectWindow::duplicate);
     ProjectWindow::connect(m_widget->undoGroup(), &QUndoGroup::cleanChanged, q, &ProjectWindow::canUndoChanged);
+    ProjectWindow::connect(m_widget->undoGroup(), &QUndoGroup::indexChanged, q, [this]() {
+        scheduleJournal();
+    });
+    ProjectWindow::connect(m_journalTimer, &QTimer::timeout, q, [this]() {
+        writeJournal();
+    });
     ProjectWindow::connect(m_widget->descriptionTab()->editor(),
                            &TextEditor::undoAvailable,
                            q,
                            &ProjectWindow::canUndoChanged);
     ProjectWindow::connect(m_widget, &ProjectWidget::pageAdded, q, &ProjectWindow::pageAdded);
     ProjectWindow::connect(m_widget, &ProjectWidget::pageDeleted, q, &ProjectWindow::pageDeleted);
+    ProjectWindow::connect(m_widget, &ProjectWidget::pageMaterialized, q, &ProjectWindow::pageMaterialized);
+    ProjectWindow::connect(m_widget,
+                           &ProjectWidget::residentPagesChanged,
+                           q,
+                           &ProjectWindow::residentPagesChanged);
+    ProjectWindow::connect(m_saver, &ProjectSaver::saved, q, &ProjectWindow::projectSaved);
+    ProjectWindow::connect(m_saver, &ProjectSaver::failed, q, &ProjectWindow::projectSaveFailed);
+    ProjectWindow::connect(m_loader, &ProjectLoader::progress, q, &ProjectWindow::projectLoadProgress);
+    ProjectWindow::connect(m_loader, &ProjectLoader::loaded, q, &ProjectWindow::projectLoaded);
+    ProjectWindow::connect(m_loader, &ProjectLoader::failed, q, &ProjectWindow::projectLoadFailed);
+    ProjectWindow::connect(m_loader, &ProjectLoader::canceled, q, &ProjectWindow::projectLoadCanceled);
+    ProjectWindow::connect(m_cancelLoad, &QToolButton::clicked, m_loader, &ProjectLoader::cancel);
+    ProjectWindow::connect(m_widget,
+                           &ProjectWidget::pagesLoadingProgress,
+                           q,
+                           &ProjectWindow::pagesLoadingProgress);
     ProjectWindow::connect(m_toTop, &QAction::triggered, q, &ProjectWindow::toTop);
     ProjectWindow::connect(m_up, &QAction::triggered, q, &ProjectWindow::raise);
     ProjectWindow::connect(m_down, &QAction::triggered, q, &ProjectWindow::lower);
@@ -659,12 +794,16 @@ void ProjectWindowPrivate::init()
     q->switchToSelectMode();
 
     q->tabChanged(0);
+
+    q->residentPagesChanged();
 }
 
 void ProjectWindowPrivate::clearEditModeInTexts()
 {
     for (const auto &p : std::as_const(m_widget->pages())) {
-        p->page()->clearEditModeInTexts();
+        if (p->isMaterialized()) {
+            p->page()->clearEditModeInTexts();
+        }
     }
 }
 
@@ -711,23 +850,106 @@ void ProjectWindowPrivate::enableEditing(const QList<QGraphicsItem *> &children,
 
 void ProjectWindowPrivate::updateCfg()
 {
+    m_widget->finishLoading();
+
+    // Pages not read yet add their images to the store when they're read,
+    // so images are taken after all pages.
+    std::vector<Cfg::Page> pages;
+    pages.reserve(std::size_t(m_widget->pages().size()));
+
+    for (const auto &page : std::as_const(m_widget->pages())) {
+        pages.push_back(page->cfg());
+    }
+
+    updateProjectCfg();
+
+    m_cfg.page() = std::move(pages);
+}
+
+void ProjectWindowPrivate::updateProjectCfg()
+{
+    m_widget->finishLoading();
     m_cfg.description().set_tabName(m_widget->projectTabName());
 
     m_cfg.description().set_text(m_widget->descriptionTab()->editor()->text());
 
     m_cfg.page().clear();
 
+    m_cfg.images() = m_widget->imageStore().usedImages();
+}
+
+QStringList ProjectWindowPrivate::serializedPages() const
+{
+    QStringList pages;
+    pages.reserve(m_widget->pages().size());
+
+    // Unchanged pages give cached text.
     for (const auto &page : std::as_const(m_widget->pages())) {
-        m_cfg.page().push_back(page->page()->cfg());
+        pages.append(page->serialized(m_cfg.precision()));
     }
 
-    m_cfg.images().clear();
+    return pages;
+}
+
+ProjectIndex ProjectWindowPrivate::projectIndex() const
+{
+    ProjectIndex index;
+    index.m_pages.reserve(m_widget->pages().size());
 
     for (const auto &page : std::as_const(m_widget->pages())) {
-        for (const auto &image : std::as_const(page->page()->imagesHash())) {
-            m_cfg.images().push_back(image);
+        index.m_pages.push_back(page->indexPage());
+    }
+
+    return index;
+}
+
+ProjectBundleChanges ProjectWindowPrivate::bundleChanges()
+{
+    m_cfg.description().set_tabName(m_widget->projectTabName());
+    m_cfg.description().set_text(m_widget->descriptionTab()->editor()->text());
+
+    ProjectBundleChanges changes;
+    changes.m_cfg.set_description(m_cfg.description());
+    changes.m_cfg.set_defaultGridStep(m_cfg.defaultGridStep());
+    changes.m_cfg.set_showGrid(m_cfg.showGrid());
+    changes.m_cfg.set_precision(m_cfg.precision());
+
+    m_savingPageFiles.clear();
+
+    const QStringList names = m_widget->pagesNames();
+
+    for (int i = 0; i < m_widget->pages().size(); ++i) {
+        PageView *page = m_widget->pages().at(i);
+
+        QString file = QFileInfo(page->pageFile()).fileName();
+
+        const bool isInBundle = (!file.isEmpty() && page->pageFile() == bundlePageFile(m_fileName, file));
+
+        // Pages not read yet are unchanged. Changed pages go to new files,
+        // the saved ones are kept until the manifest is written.
+        if (!isInBundle || page->revision() != m_savedRevisions.value(page->id(), 0)) {
+            file = newBundlePageFile();
+
+            changes.m_changed.append(qMakePair(file, page->serialized(m_cfg.precision())));
         }
+
+        changes.m_pages.append(qMakePair(names.at(i), file));
+
+        m_savingPageFiles.insert(page, bundlePageFile(m_fileName, file));
     }
+
+    ImageStore &store = m_widget->imageStore();
+
+    // Images are never rewritten, only new ones are read.
+    for (const auto &sha256 : store.usedImageIds()) {
+        const ImageHandle image = store.image(sha256);
+
+        if (!QFileInfo::exists(bundleImageFile(m_fileName, sha256, image.format()))) {
+            changes.m_newImages.push_back(image.data());
+        }
+    }
+
+    return changes;
 }
 
 void ProjectWindowPrivate::prepareForDrawing(bool editable)
@@ -735,6 +957,10 @@ void ProjectWindowPrivate::prepareForDrawing(bool editable)
     m_widget->enableSelection(false);
 
     foreach (PageView *v, m_widget->pages()) {
+        if (!v->isMaterialized()) {
+            continue;
+        }
+
         v->page()->setCursor(Qt::CrossCursor);
 
         v->page()->switchToDrawingMode();
@@ -751,6 +977,124 @@ void ProjectWindowPrivate::cleanPages()
     m_deletedForms.clear();
 }
 
+QHash<quint64, quint64> ProjectWindowPrivate::revisions() const
+{
+    QHash<quint64, quint64> res;
+
+    for (const auto &page : std::as_const(m_widget->pages())) {
+        res.insert(page->id(), page->revision());
+    }
+
+    return res;
+}
+
+QSet<QString> ProjectWindowPrivate::usedImages() const
+{
+    const QStringList images = m_widget->imageStore().usedImageIds();
+
+    return QSet<QString>(images.cbegin(), images.cend());
+}
+
+bool ProjectWindowPrivate::isEveryPageLoaded() const
+{
+    for (const auto &page : std::as_const(m_widget->pages())) {
+        if (!page->isLoaded()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void ProjectWindowPrivate::clearSavingState()
+{
+    m_savingAddedForms.clear();
+    m_savingDeletedForms.clear();
+    m_savingCommentChanged.clear();
+    m_savingTabRenamed = false;
+}
+
+void ProjectWindowPrivate::resetJournal()
+{
+    m_journalTimer->stop();
+
+    // Pages not added yet are unchanged, they have zero revision.
+    m_savedRevisions = revisions();
+    m_savingRevisions = m_savedRevisions;
+    m_journaledRevisions = m_savedRevisions;
+
+    m_savedImages = usedImages();
+    m_savingImages = m_savedImages;
+    m_journaledImages = m_savedImages;
+
+    clearSavingState();
+}
+
+void ProjectWindowPrivate::scheduleJournal()
+{
+    if (m_journal.isOpen() && !m_journalTimer->isActive()) {
+        m_journalTimer->start();
+    }
+}
+
+void ProjectWindowPrivate::writeJournal(bool checkpoint)
+{
+    if (!m_journal.isOpen() || !q->isWindowModified()) {
+        return;
+    }
+
+    // Journal holds names of all pages.
+    m_widget->finishLoading();
+
+    checkpoint = (checkpoint || m_journal.size() > c_journalCheckpointSize);
+
+    if (checkpoint) {
+        m_journaledRevisions = m_savedRevisions;
+        m_journaledImages = m_savedImages;
+    }
+
+    ProjectJournalRecord record;
+    record.m_project.description().set_tabName(m_widget->projectTabName());
+    record.m_project.description().set_text(m_widget->descriptionTab()->editor()->text());
+    record.m_project.set_defaultGridStep(m_cfg.defaultGridStep());
+    record.m_project.set_showGrid(m_cfg.showGrid());
+    record.m_project.set_precision(m_cfg.precision());
+
+    for (const auto &sha256 : m_widget->imageStore().usedImageIds()) {
+        if (!m_journaledImages.contains(sha256)) {
+            m_journaledImages.insert(sha256);
+
+            record.m_project.images().push_back(m_widget->imageStore().image(sha256).data());
+        }
+    }
+
+    record.m_pages = m_widget->pagesNames();
+
+    try {
+        for (int i = 0; i < m_widget->pages().size(); ++i) {
+            PageView *page = m_widget->pages().at(i);
+
+            if (page->revision() != m_journaledRevisions.value(page->id(), 0)) {
+                record.m_changed.append(qMakePair(record.m_pages.at(i), page->serialized(m_cfg.precision())));
+
+                m_journaledRevisions.insert(page->id(), page->revision());
+            }
+        }
+    } catch (const ProjectFileException &) {
+        // Unable to serialize, leave changes for the next batch.
+        m_journaledRevisions = m_savedRevisions;
+        m_journaledImages = m_savedImages;
+
+        return;
+    }
+
+    if (checkpoint) {
+        m_journal.checkpoint(record);
+    } else {
+        m_journal.append(record);
+    }
+}
+
 //
 // ProjectWindow
 //
@@ -803,43 +1147,16 @@ void ProjectWindow::setAuthor(const QString &name)
 
 void ProjectWindow::readProject(const QString &fileName)
 {
-    QFile file(fileName);
-
-    if (file.open(QIODevice::ReadOnly)) {
-        try {
-            Cfg::tag_Project<cfgfile::qstring_trait_t> tag;
-
-            QTextStream stream(&file);
-
-            cfgfile::read_cfgfile(tag, stream, fileName);
-
-            file.close();
-
-            newProject();
-
-            d->m_fileName = fileName;
+    d->m_loader->load(projectBundleDir(fileName));
 
-            d->m_openFolder = QFileInfo(fileName).absolutePath();
+    d->m_loadProgress->setFormat(tr("Reading %p%"));
+    d->m_loadProgress->setRange(0, 100);
+    d->m_loadProgress->setValue(0);
+    d->m_loadProgress->show();
 
-            d->m_widget->setProject(tag.get_cfg());
+    d->m_cancelLoad->show();
 
-            setWindowModified(false);
-
-            setWindowTitle(tr("Prototyper - %1[*]").arg(QFileInfo(fileName).baseName()));
-
-            switchToSelectMode();
-            d->cleanPages();
-            tabChanged(0);
-        } catch (const cfgfile::exception_t<cfgfile::qstring_trait_t> &x) {
-            file.close();
-
-            QMessageBox::warning(this,
-                                 tr("Unable to Read Project..."),
-                                 tr("Unable to read project.\n%1").arg(x.desc()));
-        }
-    } else {
-        QMessageBox::warning(this, tr("Unable to Read Project..."), tr("Unable to read project.\nUnable to open file"));
-    }
+    statusBar()->showMessage(tr("Opening project..."));
 }
 
 void ProjectWindow::closeEvent(QCloseEvent *e)
@@ -869,6 +1186,8 @@ void ProjectWindow::quit()
 {
     d->m_isQuit = true;
 
+    bool save = false;
+
     if (isWindowModified()) {
         QMessageBox::StandardButton btn = QMessageBox::question(this,
                                                                 tr("Do You Want to Save Project..."),
@@ -877,16 +1196,35 @@ void ProjectWindow::quit()
                                                                 QMessageBox::Yes);
 
         if (btn == QMessageBox::Yes) {
+            save = true;
+
             saveProjectImpl();
         }
     }
 
+    d->m_saver->waitForDone();
+
+    d->m_journalTimer->stop();
+
+    // Keep the journal if saving failed.
+    if (!save || !isWindowModified()) {
+        d->m_journal.discard();
+    } else {
+        d->m_journal.close();
+    }
+
+    d->m_journal.waitForDone();
+
+    d->m_loader->cancel();
+
     d->m_widget->tabs()->setCurrentIndex(0);
 
     TopGui::instance()->saveCfg(nullptr);
 
     for (auto *p : d->m_widget->pages()) {
-        p->scene()->clearSelection();
+        if (p->isMaterialized()) {
+            p->scene()->clearSelection();
+        }
     }
 
     QApplication::quit();
@@ -899,14 +1237,18 @@ void ProjectWindow::showHideGrid(bool show)
     d->m_cfg.set_showGrid(show);
 
     foreach (PageView *view, d->m_widget->pages()) {
-        view->page()->setGridMode(mode);
+        if (view->isMaterialized()) {
+            view->page()->setGridMode(mode);
+        }
     }
 }
 
 void ProjectWindow::snapGrid(bool on)
 {
     foreach (PageView *view, d->m_widget->pages()) {
-        view->page()->enableSnap(on);
+        if (view->isMaterialized()) {
+            view->page()->enableSnap(on);
+        }
     }
 
     PageAction::instance()->enableSnap(on);
@@ -924,10 +1266,10 @@ void ProjectWindow::setGridStep(int step,
             d->m_cfg.set_defaultGridStep(MmPx::instance().toMmX(dlg.gridStep()));
 
             foreach (PageView *view, d->m_widget->pages()) {
-                view->page()->setGridStep(dlg.gridStep());
+                view->setGridStep(dlg.gridStep());
             }
         } else if (index > 0) {
-            d->m_widget->pages()[index - 1]->page()->setGridStep(dlg.gridStep());
+            d->m_widget->pages()[index - 1]->setGridStep(dlg.gridStep());
         }
     }
 }
@@ -955,7 +1297,7 @@ void ProjectWindow::openProject()
         tr("Select Project to Open..."),
         (d->m_openFolder.isEmpty() ? QStandardPaths::standardLocations(QStandardPaths::DocumentsLocation).constFirst()
                                    : d->m_openFolder),
-        tr("Prototyper Project (*.prototyper)"));
+        tr("Prototyper Project (*.prototyper *.prototyperb *.prototyperz manifest.prototyperm)"));
 
     if (!fileName.isEmpty())
         readProject(fileName);
@@ -975,10 +1317,15 @@ void ProjectWindow::newProject()
         }
     }
 
+    // Changes are either saved or dropped by the user.
+    d->m_journal.discard();
+
     d->m_widget->newProject();
 
     d->m_fileName.clear();
 
+    d->resetJournal();
+
     setWindowTitle(tr("Prototyper - Unsaved[*]"));
 
     setWindowModified(false);
@@ -990,53 +1337,89 @@ void ProjectWindow::newProject()
 
 void ProjectWindow::saveProjectImpl(const QString &fileName)
 {
-    static const QString ext = QStringLiteral(".prototyper");
-
     if (!fileName.isEmpty()) {
+        // Changes go to the new file, its journal is opened when it's saved.
+        if (fileName != d->m_fileName) {
+            d->m_journal.discard();
+        }
+
         d->m_fileName = fileName;
     }
 
     if (!d->m_fileName.isEmpty()) {
-        d->updateCfg();
+        d->m_widget->finishLoading();
+
+        const ProjectFormat format = projectFormatForFileName(d->m_fileName);
+        const QString ext = projectFileExtension(format);
 
         if (!d->m_fileName.endsWith(ext)) {
             d->m_fileName.append(ext);
         }
 
-        QFile file(d->m_fileName);
+        // The snapshot is written on the worker thread, the state captured
+        // in it is the saved one. projectSaveFailed() marks it dirty again.
+        if (format == BundleProjectFormat) {
+            ProjectBundleChanges changes;
 
-        if (file.open(QIODevice::WriteOnly)) {
             try {
-                Cfg::tag_Project<cfgfile::qstring_trait_t> tag(d->m_cfg);
-
-                QTextStream stream(&file);
+                changes = d->bundleChanges();
+            } catch (const ProjectFileException &x) {
+                QMessageBox::warning(this,
+                                     tr("Unable to Save Project..."),
+                                     tr("Unable to save project.\n%1").arg(x.what()));
 
-                cfgfile::write_cfgfile(tag, stream);
+                return;
+            }
 
-                file.close();
+            d->m_saver->save(changes, d->m_fileName);
+        } else if (format != BinaryProjectFormat) {
+            QStringList pages;
 
-                d->m_widget->cleanUndoGroup();
+            try {
+                pages = d->serializedPages();
+            } catch (const ProjectFileException &x) {
+                QMessageBox::warning(this,
+                                     tr("Unable to Save Project..."),
+                                     tr("Unable to save project.\n%1").arg(x.what()));
 
-                d->m_widget->descriptionTab()->editor()->document()->clearUndoRedoStacks();
+                return;
+            }
 
-                d->m_widget->setTabRenamed(false);
-            } catch (const cfgfile::exception_t<cfgfile::qstring_trait_t> &x) {
-                file.close();
+            d->updateProjectCfg();
 
+            d->m_saver->save(d->m_cfg, pages, d->projectIndex(), d->m_fileName);
+        } else {
+            try {
+                d->updateCfg();
+            } catch (const ProjectFileException &x) {
                 QMessageBox::warning(this,
                                      tr("Unable to Save Project..."),
-                                     tr("Unable to save project.\n%1").arg(x.desc()));
+                                     tr("Unable to save project.\n%1").arg(x.what()));
 
                 return;
             }
-        } else {
-            QMessageBox::warning(this,
-                                 tr("Unable to Save Project..."),
-                                 tr("Unable to save project.\nUnable to open file."));
 
-            return;
+            d->m_saver->save(d->m_cfg, d->projectIndex(), d->m_fileName);
         }
 
+        d->m_savingRevisions = d->revisions();
+        d->m_savingImages = d->usedImages();
+        d->m_savingEveryPageLoaded = d->isEveryPageLoaded();
+
+        // State cleared below is brought back if the save fails.
+        d->m_savingAddedForms.append(d->m_addedForms);
+        d->m_savingDeletedForms.append(d->m_deletedForms);
+        d->m_savingCommentChanged.append(d->m_widget->commentChangedPages());
+        d->m_savingTabRenamed = (d->m_savingTabRenamed || d->m_widget->isTabRenamed());
+
+        statusBar()->showMessage(tr("Saving project..."));
+
+        d->m_widget->cleanUndoGroup();
+
+        d->m_widget->descriptionTab()->editor()->document()->clearUndoRedoStacks();
+
+        d->m_widget->setTabRenamed(false);
+
         setWindowModified(false);
 
         d->cleanPages();
@@ -1054,23 +1437,92 @@ void ProjectWindow::saveProject()
 
 void ProjectWindow::saveProjectAs()
 {
-    const QString fileName = QFileDialog::getSaveFileName(
+    const QString textFilter = tr("Prototyper Project (*.prototyper)");
+    const QString binaryFilter = tr("Prototyper Binary Project (*.prototyperb)");
+    const QString compressedFilter = tr("Prototyper Compressed Project (*.prototyperz)");
+    const QString bundleFilter = tr("Prototyper Project Bundle (*.prototyperd)");
+
+    QString selectedFilter = textFilter;
+
+    switch (projectFormatForFileName(d->m_fileName)) {
+    case BinaryProjectFormat:
+        selectedFilter = binaryFilter;
+        break;
+
+    case CompressedProjectFormat:
+        selectedFilter = compressedFilter;
+        break;
+
+    case BundleProjectFormat:
+        selectedFilter = bundleFilter;
+        break;
+
+    default:
+        break;
+    }
+
+    QString fileName = QFileDialog::getSaveFileName(
         this,
         tr("Select File to Save Project..."),
         (d->m_openFolder.isEmpty() ? QStandardPaths::standardLocations(QStandardPaths::DocumentsLocation).constFirst()
                                    : d->m_openFolder),
-        tr("Prototyper Project (*.prototyper)"));
+        textFilter + QStringLiteral(";;") + binaryFilter + QStringLiteral(";;") + compressedFilter + QStringLiteral(";;")
+            + bundleFilter,
+        &selectedFilter);
 
     if (!fileName.isEmpty()) {
+        ProjectFormat format = TextProjectFormat;
+
+        if (selectedFilter == binaryFilter) {
+            format = BinaryProjectFormat;
+        } else if (selectedFilter == compressedFilter) {
+            format = CompressedProjectFormat;
+        } else if (selectedFilter == bundleFilter) {
+            format = BundleProjectFormat;
+        }
+
+        if (!fileName.endsWith(projectFileExtension(format))) {
+            fileName.append(projectFileExtension(format));
+        }
+
         setWindowTitle(tr("Prototyper - %1[*]").arg(QFileInfo(fileName).baseName()));
 
         saveProjectImpl(fileName);
     }
 }
 
+void ProjectWindow::setPrecision()
+{
+    bool ok = false;
+
+    const double precision = QInputDialog::getDouble(this,
+                                                     tr("Save Precision"),
+                                                     tr("Round positions and sizes to, mm (zero keeps them exact):"),
+                                                     d->m_cfg.precision(),
+                                                     0.0,
+                                                     10.0,
+                                                     4,
+                                                     &ok);
+
+    if (ok && precision != d->m_cfg.precision()) {
+        d->m_cfg.set_precision(precision);
+
+        // Unchanged page files of the bundle have to be rewritten.
+        if (projectFormatForFileName(d->m_fileName) == BundleProjectFormat) {
+            for (PageView *page : d->m_widget->pages()) {
+                page->invalidateSerialized();
+            }
+        }
+
+        projectChanged();
+    }
+}
+
 void ProjectWindow::projectChanged()
 {
     setWindowModified(true);
+
+    d->scheduleJournal();
 }
 
 void ProjectWindow::drawLine()
@@ -1119,18 +1571,37 @@ void ProjectWindow::insertImage()
 {
     d->clearEditModeInTexts();
 
+    QString filter = QStringLiteral("*.png *.jpg *.jpeg *.bmp");
+
+    if (FormImage::preservedFormats().contains("webp")) {
+        filter.append(QStringLiteral(" *.webp"));
+    }
+
     const QString fileName =
         QFileDialog::getOpenFileName(this,
                                      tr("Select Image"),
                                      QStandardPaths::standardLocations(QStandardPaths::PicturesLocation).constFirst(),
-                                     tr("Image Files (*.png *.jpg *.jpeg *.bmp)"),
+                                     tr("Image Files (%1)").arg(filter),
                                      nullptr,
                                      QFileDialog::DontUseNativeDialog);
 
     QApplication::processEvents();
 
     if (!fileName.isEmpty()) {
-        QImage image(fileName);
+        QByteArray bytes;
+
+        QFile file(fileName);
+
+        if (file.open(QIODevice::ReadOnly)) {
+            bytes = file.readAll();
+
+            file.close();
+        }
+
+        QBuffer buffer(&bytes);
+        QImageReader reader(&buffer);
+        const QByteArray format = reader.format();
+        const QImage image = reader.read();
 
         if (!image.isNull()) {
             QApplication::processEvents();
@@ -1148,6 +1619,11 @@ void ProjectWindow::insertImage()
                 p = QPixmap::fromImage(image);
             }
 
+            // Original data is kept in the project if the format allows.
+            if (FormImage::preservedFormats().contains(format)) {
+                mimeData->setData(QStringLiteral("image/") + QString::fromLatin1(format), bytes);
+            }
+
             mimeData->setImageData(image);
             drag->setMimeData(mimeData);
             drag->setPixmap(p);
@@ -1196,6 +1672,10 @@ void ProjectWindow::select(bool checked)
         d->m_widget->enableSelection(true);
 
         foreach (PageView *v, d->m_widget->pages()) {
+            if (!v->isMaterialized()) {
+                continue;
+            }
+
             v->page()->setCursor(Qt::ArrowCursor);
 
             d->setFlag(v, QGraphicsItem::ItemIsSelectable, true);
@@ -1218,7 +1698,7 @@ void ProjectWindow::fillColor()
         const auto s = v->pageScene()->selectedItems();
 
         if (s.size() == 1) {
-            auto *o = dynamic_cast<FormObject *>(s.first());
+            auto *o = formObject(s.first());
 
             if (o) {
                 c = o->objectBrush().color();
@@ -1260,7 +1740,7 @@ void ProjectWindow::strokeColor()
         const auto s = v->pageScene()->selectedItems();
 
         if (s.size() == 1) {
-            auto *o = dynamic_cast<FormObject *>(s.first());
+            auto *o = formObject(s.first());
 
             if (o) {
                 c = o->objectPen().color();
@@ -1299,7 +1779,11 @@ void ProjectWindow::tabChanged(int index)
         d->m_zoomToolBar->show();
         d->m_widget->descriptionTab()->toolBar()->hide();
 
-        PageAction::instance()->setPage(d->m_widget->pages().at(index - 1)->page());
+        PageView *view = d->m_widget->pages().at(index - 1);
+
+        view->materialize();
+
+        PageAction::instance()->setPage(view->page());
 
         d->m_group->setEnabled(true);
         d->m_select->setEnabled(true);
@@ -1425,14 +1909,14 @@ void ProjectWindow::selectionChanged()
             d->m_group->setEnabled(false);
         }
 
-        if (s.size() == 1 && dynamic_cast<FormGroup *>(s.first())) {
+        if (s.size() == 1 && qgraphicsitem_cast<FormGroup *>(s.first())) {
             d->m_ungroup->setEnabled(true);
         } else {
             d->m_ungroup->setEnabled(false);
         }
 
         if (s.size() == 1) {
-            auto *o = dynamic_cast<FormObject *>(s.first());
+            auto *o = formObject(s.first());
 
             if (o) {
                 auto *widget = o->properties(this);
@@ -1494,7 +1978,13 @@ void ProjectWindow::exportToPDf()
         file.close();
 
         if (canModify) {
-            d->updateCfg();
+            try {
+                d->updateCfg();
+            } catch (const ProjectFileException &x) {
+                QMessageBox::critical(this, tr("Unable to export..."), x.what());
+
+                return;
+            }
 
             PdfExporter exporter(d->m_cfg);
 
@@ -1544,7 +2034,13 @@ void ProjectWindow::exportToHtml()
         file.close();
 
         if (canModify) {
-            d->updateCfg();
+            try {
+                d->updateCfg();
+            } catch (const ProjectFileException &x) {
+                QMessageBox::critical(this, tr("Unable to export..."), x.what());
+
+                return;
+            }
 
             HtmlExporter exporter(d->m_cfg);
 
@@ -1585,6 +2081,8 @@ void ProjectWindow::exportToSvg()
             exporter.exportToDoc(dirName);
         } catch (const SvgExporterException &e) {
             QMessageBox::critical(this, tr("Unable to export..."), e.what());
+        } catch (const ProjectFileException &x) {
+            QMessageBox::critical(this, tr("Unable to export..."), x.what());
         }
     }
 }
@@ -1737,11 +2235,284 @@ void ProjectWindow::pageAdded(Prototyper::Core::PageView *form)
 
 void ProjectWindow::pageDeleted(Prototyper::Core::PageView *form)
 {
+    d->m_savedRevisions.remove(form->id());
+    d->m_savingRevisions.remove(form->id());
+    d->m_journaledRevisions.remove(form->id());
+    d->m_savingPageFiles.remove(form);
+
     d->m_deletedForms.append(form);
 
     if (d->m_addedForms.contains(form)) {
         d->m_addedForms.removeOne(form);
     }
+
+    d->m_savingAddedForms.removeAll(form);
+    d->m_savingCommentChanged.removeAll(form);
+}
+
+void ProjectWindow::pageMaterialized(Prototyper::Core::PageView *form)
+{
+    form->page()->enableSnap(PageAction::instance()->isSnapEnabled());
+
+    if (PageAction::instance()->mode() == PageAction::Select) {
+        form->enableSelection(true);
+
+        form->page()->setCursor(Qt::ArrowCursor);
+
+        d->setFlag(form, QGraphicsItem::ItemIsSelectable, true);
+
+        d->enableEditing(form, false);
+
+        form->page()->switchToSelectMode();
+    } else {
+        form->enableSelection(false);
+
+        form->page()->setCursor(Qt::CrossCursor);
+
+        form->page()->switchToDrawingMode();
+
+        d->setFlag(form, QGraphicsItem::ItemIsSelectable, false);
+
+        d->enableEditing(form, PageAction::instance()->mode() == PageAction::InsertText);
+    }
+}
+
+void ProjectWindow::residentPagesChanged()
+{
+    d->m_residentPages->setText(tr("Pages in memory: %1 / %2")
+                                    .arg(QString::number(d->m_widget->residentPagesCount()),
+                                         QString::number(d->m_widget->pages().size())));
+}
+
+void ProjectWindow::projectSaved(const QString &fileName)
+{
+    if (!d->m_saver->isBusy()) {
+        d->clearSavingState();
+
+        statusBar()->showMessage(tr("Project saved to \"%1\".").arg(QFileInfo(fileName).fileName()),
+                                 c_statusMessageTimeout);
+
+        if (fileName == d->m_fileName) {
+            d->m_savedRevisions = d->m_savingRevisions;
+            d->m_savedImages = d->m_savingImages;
+
+            if (projectFormatForFileName(fileName) == BundleProjectFormat) {
+                for (auto it = d->m_savingPageFiles.cbegin(), last = d->m_savingPageFiles.cend(); it != last; ++it) {
+                    it.key()->setPageFile(it.value());
+                }
+
+                d->m_savingPageFiles.clear();
+
+                // Pages not read hold no images in the store, their images are kept.
+                if (d->m_savingEveryPageLoaded) {
+                    // No save refers to other images now.
+                    QStringList images;
+
+                    for (const auto &sha256 : std::as_const(d->m_savedImages)) {
+                        images.append(bundleImageFile(sha256, d->m_widget->imageStore().image(sha256).format()));
+                    }
+
+                    removeUnusedBundleImages(fileName, images);
+                }
+            }
+
+            d->m_journal.open(fileName);
+
+            if (isWindowModified()) {
+                // Keep only changes made after the snapshot.
+                d->writeJournal(true);
+            } else {
+                d->m_journal.discard();
+                d->m_journal.open(fileName);
+
+                d->m_journaledRevisions = d->m_savedRevisions;
+                d->m_journaledImages = d->m_savedImages;
+            }
+        }
+    }
+}
+
+void ProjectWindow::projectSaveFailed(const QString &fileName,
+                                      const QString &error)
+{
+    statusBar()->clearMessage();
+
+    // The project was replaced while saving, its state is gone.
+    if (fileName != d->m_fileName) {
+        QMessageBox::warning(this, tr("Unable to Save Project..."), tr("Unable to save project.\n%1").arg(error));
+
+        return;
+    }
+
+    foreach (QUndoStack *s, d->m_widget->undoGroup()->stacks())
+        s->resetClean();
+
+    for (const auto &form : std::as_const(d->m_savingAddedForms)) {
+        if (!d->m_addedForms.contains(form)) {
+            d->m_addedForms.append(form);
+        }
+    }
+
+    for (const auto &form : std::as_const(d->m_savingDeletedForms)) {
+        if (!d->m_deletedForms.contains(form)) {
+            d->m_deletedForms.append(form);
+        }
+    }
+
+    d->m_widget->setCommentChanged(d->m_savingCommentChanged);
+
+    if (d->m_savingTabRenamed) {
+        d->m_widget->setTabRenamed();
+    }
+
+    d->clearSavingState();
+
+    setWindowModified(true);
+
+    QMessageBox::warning(this, tr("Unable to Save Project..."), tr("Unable to save project.\n%1").arg(error));
+}
+
+void ProjectWindow::projectLoadProgress(qint64 done,
+                                        qint64 total)
+{
+    d->m_loadProgress->setValue(total > 0 ? int(done * 100 / total) : 100);
+}
+
+void ProjectWindow::projectLoaded(const QString &fileName,
+                                  const Prototyper::Core::Cfg::Project &cfg,
+                                  const QHash<QString, QImage> &images,
+                                  const Prototyper::Core::ProjectBundle &bundle)
+{
+    d->m_loadProgress->hide();
+    d->m_cancelLoad->hide();
+
+    statusBar()->clearMessage();
+
+    newProject();
+
+    d->m_fileName = fileName;
+
+    d->m_openFolder = QFileInfo(fileName).absolutePath();
+
+    d->m_journal.open(fileName);
+
+    Cfg::Project project = cfg;
+    QStringList recoveredPages;
+    bool recovered = false;
+
+    if (ProjectJournal::exists(fileName)) {
+        const QMessageBox::StandardButton btn =
+            QMessageBox::question(this,
+                                  tr("Recover Unsaved Changes..."),
+                                  tr("Unsaved changes of the project from the previous session were found.\n"
+                                     "Do you want to recover them?"),
+                                  QMessageBox::Yes | QMessageBox::No,
+                                  QMessageBox::Yes);
+
+        if (btn == QMessageBox::Yes) {
+            try {
+                project = replayJournal(cfg, ProjectJournal::fileName(fileName), &recoveredPages);
+
+                recovered = true;
+            } catch (const ProjectFileException &x) {
+                QMessageBox::warning(this,
+                                     tr("Unable to Recover Changes..."),
+                                     tr("Unable to recover changes.\n%1").arg(x.what()));
+            }
+        }
+
+        if (!recovered) {
+            d->m_journal.discard();
+            d->m_journal.open(fileName);
+        }
+    }
+
+    // Recovered pages are taken from the journal, not from their files.
+    ProjectBundle pageFiles = bundle;
+
+    for (const auto &name : std::as_const(recoveredPages)) {
+        pageFiles.m_pages.remove(name);
+    }
+
+    d->m_widget->setProject(project, images, pageFiles);
+
+    setWindowModified(false);
+
+    setWindowTitle(tr("Prototyper - %1[*]").arg(QFileInfo(fileName).baseName()));
+
+    switchToSelectMode();
+    d->cleanPages();
+    tabChanged(0);
+
+    d->resetJournal();
+
+    if (recovered) {
+        // Saved file differs from the recovered pages and images.
+        d->m_savedImages.clear();
+
+        for (const auto &image : cfg.images()) {
+            d->m_savedImages.insert(image.sha256());
+        }
+
+        for (auto it = bundle.m_images.cbegin(), last = bundle.m_images.cend(); it != last; ++it) {
+            d->m_savedImages.insert(it.key());
+        }
+
+        d->m_widget->finishLoading();
+
+        const QStringList names = d->m_widget->pagesNames();
+
+        for (int i = 0; i < names.size(); ++i) {
+            if (recoveredPages.contains(names.at(i))) {
+                d->m_widget->pages().at(i)->invalidateSerialized();
+            }
+        }
+
+        setWindowModified(true);
+
+        d->writeJournal(true);
+    }
+}
+
+void ProjectWindow::projectLoadFailed(const QString &fileName,
+                                      const QString &error)
+{
+    Q_UNUSED(fileName)
+
+    d->m_loadProgress->hide();
+    d->m_cancelLoad->hide();
+
+    statusBar()->clearMessage();
+
+    QMessageBox::warning(this, tr("Unable to Read Project..."), tr("Unable to read project.\n%1").arg(error));
+}
+
+void ProjectWindow::projectLoadCanceled(const QString &fileName)
+{
+    Q_UNUSED(fileName)
+
+    // Canceled in favour of another file.
+    if (d->m_loader->isBusy()) {
+        return;
+    }
+
+    d->m_loadProgress->hide();
+    d->m_cancelLoad->hide();
+
+    statusBar()->showMessage(tr("Opening of the project canceled."), c_statusMessageTimeout);
+}
+
+void ProjectWindow::pagesLoadingProgress(int loaded,
+                                         int total)
+{
+    if (loaded < total) {
+        d->m_loadProgress->setFormat(tr("Pages %v / %m"));
+        d->m_loadProgress->setRange(0, total);
+        d->m_loadProgress->setValue(loaded);
+        d->m_loadProgress->show();
+    } else {
+        d->m_loadProgress->hide();
+    }
 }
 
 void ProjectWindow::zoomIn()
@@ -8,11 +8,17 @@
 #define PROTOTYPER__CORE__PROJECT_WINDOW_HPP__INCLUDED
 
 // Qt include.
+#include <QHash>
+#include <QImage>
 #include <QMainWindow>
 
 // C++ include.
 #include <memory>
 
+// Prototyper include.
+#include "project_bundle.hpp"
+#include "project_cfg.hpp"
+
 namespace Prototyper
 {
 
@@ -91,6 +97,8 @@ private slots:
     void saveProject();
     //! Save project as.
     void saveProjectAs();
+    //! Set precision lengths are rounded to on save.
+    void setPrecision();
     //! Project changed.
     void projectChanged();
     //! Draw line.
@@ -157,6 +165,31 @@ private slots:
     void pageAdded(Prototyper::Core::PageView *form);
     //! Page deleted.
     void pageDeleted(Prototyper::Core::PageView *form);
+    //! Page's scene was built.
+    void pageMaterialized(Prototyper::Core::PageView *form);
+    //! Count of pages with built scenes changed.
+    void residentPagesChanged();
+    //! Project has been saved.
+    void projectSaved(const QString &fileName);
+    //! Unable to save project.
+    void projectSaveFailed(const QString &fileName,
+                           const QString &error);
+    //! Bytes of the opened project were read.
+    void projectLoadProgress(qint64 done,
+                             qint64 total);
+    //! Project has been read.
+    void projectLoaded(const QString &fileName,
+                       const Prototyper::Core::Cfg::Project &cfg,
+                       const QHash<QString, QImage> &images,
+                       const Prototyper::Core::ProjectBundle &bundle);
+    //! Unable to read project.
+    void projectLoadFailed(const QString &fileName,
+                           const QString &error);
+    //! Reading of the project was canceled.
+    void projectLoadCanceled(const QString &fileName);
+    //! Pages of the opened project were added.
+    void pagesLoadingProgress(int loaded,
+                              int total);
     //! Zoom in.
     void zoomIn();
     //! Zoom out.
@@ -6,6 +6,8 @@
 
 // Prototyper include.
 #include "top_gui.hpp"
+#include "constants.hpp"
+#include "form/actions.hpp"
 #include "project_widget.hpp"
 #include "project_window.hpp"
 #include "session_cfg.hpp"
@@ -111,6 +113,8 @@ void TopGuiPrivate::init()
 
     QString projectFileName;
     QString author;
+    int pagesMemoryBudget = c_defaultPagesMemoryBudget;
+    bool renderCache = false;
 
     QFile file(m_appSessionCfgFileName);
 
@@ -126,6 +130,8 @@ void TopGuiPrivate::init()
 
             projectFileName = tag.get_cfg().project();
             author = tag.get_cfg().author();
+            pagesMemoryBudget = tag.get_cfg().pagesMemoryBudget();
+            renderCache = tag.get_cfg().renderCache();
         } catch (const cfgfile::exception_t<cfgfile::qstring_trait_t> &) {
             file.close();
         }
@@ -135,6 +141,12 @@ void TopGuiPrivate::init()
         m_projectWindow->setAuthor(author);
     }
 
+    if (pagesMemoryBudget > 0) {
+        m_projectWindow->projectWidget()->setMemoryBudget(qint64(pagesMemoryBudget) * 1024 * 1024);
+    }
+
+    PageAction::instance()->enableRenderCache(renderCache);
+
     if (!projectFileName.isEmpty() && QFileInfo::exists(projectFileName)) {
         m_projectWindow->readProject(projectFileName);
     }
@@ -257,6 +269,8 @@ void TopGui::saveCfg(QWidget *parent)
             Cfg::Session s;
             s.set_project(d->m_projectWindow->projectFileName());
             s.set_author(d->m_projectWindow->author());
+            s.set_pagesMemoryBudget(int(d->m_projectWindow->projectWidget()->memoryBudget() / 1024 / 1024));
+            s.set_renderCache(PageAction::instance()->isRenderCacheEnabled());
 
             Cfg::tag_Session<cfgfile::qstring_trait_t> tag(s);
 
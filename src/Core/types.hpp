@@ -10,6 +10,7 @@
 #include "project_cfg.hpp"
 
 // Qt include.
+#include <QGraphicsItem>
 #include <QHash>
 #include <QString>
 
@@ -34,6 +35,32 @@ enum GridMode {
     NoGrid = 2
 }; // enum GridMode
 
+//
+// ItemType
+//
+
+//! Types of graphics items, see QGraphicsItem::type().
+enum ItemType {
+    //! Form objects, type of the object is added to it.
+    FormObjectItemType = QGraphicsItem::UserType,
+    //! Move handle.
+    MoveHandleItemType = QGraphicsItem::UserType + 100,
+    //! Resize handle.
+    ResizeHandleItemType,
+    //! Aspect ratio handle.
+    AspectRatioHandleItemType,
+    //! Nodes edit and resize handle.
+    NodesEditResizeHandleItemType,
+    //! Resizable proxy.
+    ResizableProxyItemType,
+    //! Comment.
+    CommentItemType,
+    //! Grid snap.
+    GridSnapItemType,
+    //! Rect placer.
+    RectPlacerItemType
+}; // enum ItemType
+
 } /* namespace Core */
 
 } /* namespace Prototyper */
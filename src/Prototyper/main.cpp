@@ -6,20 +6,100 @@
 
 // Qt include.
 #include <QApplication>
+#include <QCommandLineParser>
 #include <QIcon>
 #include <QTranslator>
 
+// C++ include.
+#include <cstring>
+
 // Prototyper include.
+#include <Core/batch_export.hpp>
 #include <Core/project_window.hpp>
 #include <Core/top_gui.hpp>
 
 using namespace Prototyper::Core;
 
+//! \return Is application started in the batch mode?
+static inline bool isBatchExport(int argc,
+                                 char **argv)
+{
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--export") == 0 || std::strncmp(argv[i], "--export=", 9) == 0
+            || std::strcmp(argv[i], "--convert") == 0 || std::strcmp(argv[i], "--list") == 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//! Export project without GUI.
+static inline int runBatchExport()
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Prototyper - Simple UI prototyping software."));
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    const QCommandLineOption exportOption(QStringLiteral("export"),
+                                          QStringLiteral("Export project to the given format: pdf, svg or html."),
+                                          QStringLiteral("format"));
+    parser.addOption(exportOption);
+    const QCommandLineOption convertOption(QStringLiteral("convert"),
+                                           QStringLiteral("Convert project, format is chosen by the output's "
+                                                          "extension: .prototyper, .prototyperb, .prototyperz "
+                                                          "or .prototyperd."));
+    parser.addOption(convertOption);
+    const QCommandLineOption listOption(QStringLiteral("list"),
+                                        QStringLiteral("List pages of the project from its index as JSON."));
+    parser.addOption(listOption);
+    parser.addPositionalArgument(QStringLiteral("input"), QStringLiteral("Project file."));
+    parser.addPositionalArgument(QStringLiteral("output"), QStringLiteral("Output file, or directory for SVG."));
+
+    // Results of the batch mode are JSON, so are help and errors.
+    if (!parser.parse(QCoreApplication::arguments())) {
+        return batchUsage(parser.helpText(), parser.errorText());
+    }
+
+    if (parser.isSet(helpOption) || parser.isSet(QStringLiteral("help-all"))) {
+        return batchUsage(parser.helpText());
+    }
+
+    const QStringList args = parser.positionalArguments();
+
+    const int modes = int(parser.isSet(exportOption)) + int(parser.isSet(convertOption))
+        + int(parser.isSet(listOption));
+
+    if (modes != 1 || args.size() != (parser.isSet(listOption) ? 1 : 2)) {
+        return batchUsage(parser.helpText(), QStringLiteral("Wrong arguments."));
+    }
+
+    if (parser.isSet(listOption)) {
+        return listProject(args.at(0));
+    }
+
+    if (parser.isSet(convertOption)) {
+        return convertProject(args.at(0), args.at(1));
+    }
+
+    return batchExport(parser.value(exportOption), args.at(0), args.at(1));
+}
+
 int main(int argc,
          char **argv)
 {
+    const bool batch = isBatchExport(argc, argv);
+
+    if (batch && qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
     QApplication app(argc, argv);
 
+    if (batch) {
+        return runBatchExport();
+    }
+
     QIcon appIcon(QStringLiteral(":/img/Prototyper_256x256.png"));
     appIcon.addFile(QStringLiteral(":/img/Prototyper_128x128.png"));
     appIcon.addFile(QStringLiteral(":/img/Prototyper_64x64.png"));